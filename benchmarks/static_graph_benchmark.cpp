@@ -0,0 +1,125 @@
+// Per-inference overhead of the type-level StaticGraph against the runtime Executor.
+// Both evaluate the same batch-1 784-128-64-10 stack of dense layers with identical weights.
+// The Executor's kernels differ from StaticGraph's, so its dispatch overhead is measured against
+// calling those same kernels directly on preallocated tensors.
+#include <graph/constant.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/static_graph.h>
+#include <kernels/layers.h>
+#include <runtime/executor.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace sg = yt::graph::static_graph;
+
+namespace {
+
+using In = sg::Input<0, sg::StaticShape<1, 784>>;
+using Hidden1 = sg::Dense<In, 128>;
+using Hidden2 = sg::Dense<Hidden1, 64>;
+using Logits = sg::Dense<Hidden2, 10>;
+using Mlp = sg::StaticGraph<Logits>;
+
+template<typename Container>
+void fillRandom(Container &values, std::mt19937 &gen)
+{
+    std::uniform_real_distribution<float> distrib {-0.1f, 0.1f};
+    for (auto &value : values)
+        value = distrib(gen);
+}
+
+std::shared_ptr<yt::graph::Constant> makeConstant(const float *values, yt::Shape shape)
+{
+    yt::Tensor tensor {yt::fp32, std::move(shape)};
+    std::copy(values, values + tensor.numElements(), tensor.data<float>());
+    return std::make_shared<yt::graph::Constant>(std::move(tensor));
+}
+
+// Best of several rounds, so a noisy neighbour doesn't skew one side of a comparison
+template<typename Function>
+double microsecondsPerCall(Function &&function, std::size_t iterations)
+{
+    constexpr std::size_t kRounds = 5;
+    for (std::size_t i = 0; i < iterations / 10 + 1; i++)
+        function();
+    auto perRound = std::max<std::size_t>(iterations / kRounds, 1);
+    auto best = std::numeric_limits<double>::infinity();
+    for (std::size_t round = 0; round < kRounds; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < perRound; i++)
+            function();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / perRound);
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 20000;
+    std::mt19937 gen {42};
+    auto model = std::make_unique<Mlp>();
+    fillRandom(model->parameters<Hidden1>().weights, gen);
+    fillRandom(model->parameters<Hidden1>().bias, gen);
+    fillRandom(model->parameters<Hidden2>().weights, gen);
+    fillRandom(model->parameters<Hidden2>().bias, gen);
+    fillRandom(model->parameters<Logits>().weights, gen);
+    fillRandom(model->parameters<Logits>().bias, gen);
+
+    auto x = std::make_shared<yt::graph::Input>(yt::fp32, yt::Shape{1, 784}, "x");
+    auto w1 = makeConstant(model->parameters<Hidden1>().weights.data(), {784, 128});
+    auto b1 = makeConstant(model->parameters<Hidden1>().bias.data(), {128});
+    auto w2 = makeConstant(model->parameters<Hidden2>().weights.data(), {128, 64});
+    auto b2 = makeConstant(model->parameters<Hidden2>().bias.data(), {64});
+    auto w3 = makeConstant(model->parameters<Logits>().weights.data(), {64, 10});
+    auto b3 = makeConstant(model->parameters<Logits>().bias.data(), {10});
+    auto hidden1 = std::make_shared<yt::graph::Dense>(*x, *w1, *b1);
+    auto hidden2 = std::make_shared<yt::graph::Dense>(*hidden1, *w2, *b2);
+    auto logits = std::make_shared<yt::graph::Dense>(*hidden2, *w3, *b3);
+    auto output = std::make_shared<yt::graph::Output>(*logits);
+    yt::runtime::Executor executor {{x}, {output}};
+
+    yt::Tensor input {yt::fp32, {1, 784}};
+    std::uniform_real_distribution<float> pixel {0.f, 1.f};
+    std::generate_n(input.data<float>(), input.numElements(), [&]() { return pixel(gen); });
+    std::array<float, 10> staticLogits {};
+    std::vector<yt::Tensor> runtimeLogits;
+
+    auto staticTime = microsecondsPerCall([&]() { model->run({input.data<float>()}, {staticLogits.data()}); },
+                                          iterations);
+    auto runtimeTime = microsecondsPerCall([&]() { runtimeLogits = executor.run({input}); }, iterations);
+
+    yt::Tensor h1 {yt::fp32, {1, 128}}, h2 {yt::fp32, {1, 64}}, y {yt::fp32, {1, 10}};
+    auto tiling1 = yt::kernels::tunedGemmTiling(1, 128, 784);
+    auto tiling2 = yt::kernels::tunedGemmTiling(1, 64, 128);
+    auto tiling3 = yt::kernels::tunedGemmTiling(1, 10, 64);
+    auto kernelTime = microsecondsPerCall([&]() {
+        yt::kernels::dense(input, w1->value(), b1->value(), h1, tiling1);
+        yt::kernels::dense(h1, w2->value(), b2->value(), h2, tiling2);
+        yt::kernels::dense(h2, w3->value(), b3->value(), y, tiling3);
+    }, iterations);
+
+    float maxDifference {};
+    for (std::size_t i = 0; i < staticLogits.size(); i++)
+        maxDifference = std::max(maxDifference, std::abs(staticLogits[i] - runtimeLogits[0].data<float>()[i]));
+
+    std::cout << "MLP 784-128-64-10, batch 1, " << iterations << " iterations\n"
+              << "  StaticGraph: " << staticTime << " us/inference\n"
+              << "  Executor:    " << runtimeTime << " us/inference\n"
+              << "  its kernels: " << kernelTime << " us/inference\n"
+              << "  dispatch overhead: " << runtimeTime - kernelTime << " us/inference\n"
+              << "  max |difference|: " << maxDifference << '\n';
+    return maxDifference < 1e-4f ? EXIT_SUCCESS : EXIT_FAILURE;
+}
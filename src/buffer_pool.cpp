@@ -0,0 +1,237 @@
+#include "buffer_pool.h"
+#include "tensor.h"
+#include <cstdlib>
+#include <new>
+
+namespace yt {
+
+namespace {
+
+thread_local bool threadCacheDestroyed = false;
+
+void updateMax(std::atomic<std::size_t> &max, std::size_t value)
+{
+    auto current = max.load(std::memory_order_relaxed);
+    while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+}
+
+bool tryPush(std::vector<void*> &bin, void *ptr)
+{
+    try
+    {
+        bin.push_back(ptr);
+        return true;
+    }
+    catch (const std::bad_alloc &)
+    {
+        return false;
+    }
+}
+
+} // anonymous
+
+struct BufferPool::ThreadCache
+{
+    Bins bins {};
+    std::size_t bytes {};
+
+    ~ThreadCache()
+    {
+        auto &pool = BufferPool::instance();
+        for (std::size_t sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++)
+            for (auto ptr : bins[sizeClass])
+                pool.releaseToShared(ptr, sizeClass);
+        threadCacheDestroyed = true;
+    }
+};
+
+BufferPool &BufferPool::instance()
+{
+    // Never destroyed: tensors held by other statics may be released during static destruction
+    static auto *pool = new BufferPool;
+    return *pool;
+}
+
+BufferPool::ThreadCache *BufferPool::threadCache()
+{
+    if (threadCacheDestroyed)
+        return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+std::size_t BufferPool::sizeClassOf(std::size_t sizeInBytes)
+{
+    // 64, 128, 192, 256, then (2^exponent, 2^(exponent + 1)] split into four equal steps,
+    // which keeps every class a multiple of the 64-byte alignment
+    if (sizeInBytes <= 4 * kMinPooledSize)
+        return sizeInBytes ? (sizeInBytes - 1) / kMinPooledSize : 0;
+    if (sizeInBytes > kMaxPooledSize)
+        return kUnpooled;
+    std::size_t exponent = 8;
+    while ((std::size_t {1} << (exponent + 1)) < sizeInBytes)
+        exponent++;
+    auto step = std::size_t {1} << (exponent - 2);
+    auto quarter = (sizeInBytes - (std::size_t {1} << exponent) + step - 1) / step;
+    return 4 + (exponent - 8) * 4 + (quarter - 1);
+}
+
+std::size_t BufferPool::sizeOfClass(std::size_t sizeClass)
+{
+    if (sizeClass < 4)
+        return (sizeClass + 1) * kMinPooledSize;
+    auto exponent = 8 + (sizeClass - 4) / 4;
+    auto quarter = (sizeClass - 4) % 4 + 1;
+    return (std::size_t {1} << exponent) + quarter * (std::size_t {1} << (exponent - 2));
+}
+
+std::shared_ptr<void> BufferPool::allocate(std::size_t sizeInBytes)
+{
+    auto sizeClass = sizeClassOf(sizeInBytes);
+    auto size = sizeClass == kUnpooled ?
+        (sizeInBytes + Tensor::kAlignment - 1) / Tensor::kAlignment * Tensor::kAlignment : sizeOfClass(sizeClass);
+    void *ptr = sizeClass == kUnpooled ? nullptr : take(sizeClass);
+    if (ptr)
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    else
+    {
+        ptr = systemAllocate(size);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto inUse = bytesInUse_.fetch_add(size, std::memory_order_relaxed) + size;
+    updateMax(highWaterMark_, inUse + bytesHeld_.load(std::memory_order_relaxed));
+    // If the control block allocation throws, shared_ptr hands ptr to the deleter, which undoes the accounting
+    return {ptr, Deleter {sizeClass, size}};
+}
+
+BufferPoolStats BufferPool::stats() const
+{
+    BufferPoolStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.bytesHeld = bytesHeld_.load(std::memory_order_relaxed);
+    stats.bytesInUse = bytesInUse_.load(std::memory_order_relaxed);
+    stats.highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BufferPool::setMaxBytesHeld(std::size_t maxBytesHeld)
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    maxBytesHeld_ = maxBytesHeld;
+    for (auto sizeClass = kNumSizeClasses; sizeClass-- > 0 && sharedBytes_ > maxBytesHeld_;)
+    {
+        auto &bin = bins_[sizeClass];
+        auto size = sizeOfClass(sizeClass);
+        while (!bin.empty() && sharedBytes_ > maxBytesHeld_)
+        {
+            systemFree(bin.back(), size);
+            bin.pop_back();
+            sharedBytes_ -= size;
+        }
+    }
+}
+
+std::size_t BufferPool::trim()
+{
+    auto held = bytesHeld_.load(std::memory_order_relaxed);
+    if (auto cache = threadCache())
+    {
+        for (std::size_t sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++)
+        {
+            auto size = sizeOfClass(sizeClass);
+            for (auto ptr : cache->bins[sizeClass])
+                systemFree(ptr, size);
+            cache->bins[sizeClass].clear();
+        }
+        cache->bytes = 0;
+    }
+    std::lock_guard<std::mutex> lock {mutex_};
+    for (std::size_t sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++)
+    {
+        auto size = sizeOfClass(sizeClass);
+        for (auto ptr : bins_[sizeClass])
+            systemFree(ptr, size);
+        bins_[sizeClass].clear();
+    }
+    sharedBytes_ = 0;
+    auto remaining = bytesHeld_.load(std::memory_order_relaxed);
+    return held > remaining ? held - remaining : 0;
+}
+
+void *BufferPool::take(std::size_t sizeClass)
+{
+    auto size = sizeOfClass(sizeClass);
+    void *ptr = nullptr;
+    auto cache = threadCache();
+    if (cache && !cache->bins[sizeClass].empty())
+    {
+        ptr = cache->bins[sizeClass].back();
+        cache->bins[sizeClass].pop_back();
+        cache->bytes -= size;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        auto &bin = bins_[sizeClass];
+        if (bin.empty())
+            return nullptr;
+        ptr = bin.back();
+        bin.pop_back();
+        sharedBytes_ -= size;
+    }
+    bytesHeld_.fetch_sub(size, std::memory_order_relaxed);
+    return ptr;
+}
+
+void BufferPool::release(void *ptr, std::size_t sizeClass, std::size_t size)
+{
+    bytesInUse_.fetch_sub(size, std::memory_order_relaxed);
+    if (sizeClass == kUnpooled)
+    {
+        std::free(ptr);
+        return;
+    }
+    bytesHeld_.fetch_add(size, std::memory_order_relaxed);
+    auto cache = threadCache();
+    if (cache && cache->bytes + size <= kThreadCacheBytes && tryPush(cache->bins[sizeClass], ptr))
+        cache->bytes += size;
+    else
+        releaseToShared(ptr, sizeClass);
+}
+
+// Expects ptr to be already accounted in bytesHeld_
+void BufferPool::releaseToShared(void *ptr, std::size_t sizeClass)
+{
+    auto size = sizeOfClass(sizeClass);
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (sharedBytes_ + size <= maxBytesHeld_ && tryPush(bins_[sizeClass], ptr))
+        sharedBytes_ += size;
+    else
+        systemFree(ptr, size);
+}
+
+void *BufferPool::systemAllocate(std::size_t size)
+{
+    void *ptr = std::aligned_alloc(Tensor::kAlignment, size);
+    // Cached buffers of other size classes may be what stands between us and success
+    if (!ptr && trim())
+        ptr = std::aligned_alloc(Tensor::kAlignment, size);
+    if (!ptr)
+        throw std::bad_alloc{};
+    return ptr;
+}
+
+void BufferPool::systemFree(void *ptr, std::size_t size)
+{
+    std::free(ptr);
+    bytesHeld_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void BufferPool::Deleter::operator()(void *ptr) const
+{
+    BufferPool::instance().release(ptr, sizeClass, size);
+}
+
+} // yt
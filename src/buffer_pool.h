@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace yt {
+
+struct BufferPoolStats
+{
+    std::size_t hits {};
+    std::size_t misses {};
+    std::size_t bytesHeld {};       // free bytes cached by the pool (all threads)
+    std::size_t bytesInUse {};      // bytes handed out and not yet released
+    std::size_t highWaterMark {};   // peak of bytesHeld + bytesInUse
+};
+
+// Process-wide pool of 64-byte aligned buffers.
+// Requests are rounded up to size classes (four per power of two, so at most 25% slack above 256 bytes); released
+// buffers go to a small per-thread cache first and spill into shared bins, so the steady state of a
+// repeated graph run does not touch the system allocator. Requests above kMaxPooledSize bypass the pool.
+class BufferPool
+{
+public:
+    static constexpr std::size_t kMinPooledSize = 64;
+    static constexpr std::size_t kMaxPooledSize = std::size_t {1} << 30;
+    static constexpr std::size_t kThreadCacheBytes = std::size_t {4} << 20;
+    static constexpr std::size_t kDefaultMaxBytesHeld = std::size_t {256} << 20;
+
+    static BufferPool &instance();
+
+    std::shared_ptr<void> allocate(std::size_t sizeInBytes);
+    BufferPoolStats stats() const;
+    // Caps the bytes kept in the shared bins, kDefaultMaxBytesHeld until set; excess releases go straight
+    // back to the system
+    void setMaxBytesHeld(std::size_t maxBytesHeld);
+    // Frees the shared bins and the calling thread's cache, returns the number of bytes released.
+    // Other threads' caches are bounded by kThreadCacheBytes and are flushed when those threads exit.
+    std::size_t trim();
+
+    static std::size_t sizeClassOf(std::size_t sizeInBytes);
+    static std::size_t sizeOfClass(std::size_t sizeClass);
+
+private:
+    static constexpr std::size_t kNumSizeClasses = 4 + 4 * 22;  // up to 256 B by 64 B, then quarter steps to 1 GiB
+    static constexpr std::size_t kUnpooled = kNumSizeClasses;
+    using Bins = std::array<std::vector<void*>, kNumSizeClasses>;
+
+    struct Deleter
+    {
+        std::size_t sizeClass;
+        std::size_t size;
+        void operator()(void *ptr) const;
+    };
+    struct ThreadCache;
+    friend struct ThreadCache;
+
+    BufferPool() = default;
+    static ThreadCache *threadCache();
+    void *take(std::size_t sizeClass);
+    void release(void *ptr, std::size_t sizeClass, std::size_t size);
+    void releaseToShared(void *ptr, std::size_t sizeClass);
+    void *systemAllocate(std::size_t size);
+    void systemFree(void *ptr, std::size_t size);
+
+    mutable std::mutex mutex_ {};
+    Bins bins_ {};
+    std::size_t maxBytesHeld_ {kDefaultMaxBytesHeld};
+    std::size_t sharedBytes_ {};
+    std::atomic<std::size_t> hits_ {};
+    std::atomic<std::size_t> misses_ {};
+    std::atomic<std::size_t> bytesHeld_ {};
+    std::atomic<std::size_t> bytesInUse_ {};
+    std::atomic<std::size_t> highWaterMark_ {};
+};
+
+} // yt
@@ -0,0 +1,228 @@
+#include "augmentation.h"
+#include <runtime/thread_pool.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace dataset {
+
+namespace {
+
+// Padding around the source image so that bilinear taps never leave the buffer: one zero
+// column/row before the image and two after it
+constexpr int kPadBefore = 1;
+constexpr int kPadAfter = 2;
+
+std::uint64_t splitMix64(std::uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+struct SamplingRow
+{
+    const float *padded;
+    int paddedWidth;
+    float maxX;
+    float maxY;
+};
+
+void sampleRowScalar(const SamplingRow &row, const float *xs, const float *ys, float *dst, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        auto x = std::clamp(xs[i], -1.f, row.maxX);
+        auto y = std::clamp(ys[i], -1.f, row.maxY);
+        auto x0 = std::floor(x);
+        auto y0 = std::floor(y);
+        auto fx = x - x0;
+        auto fy = y - y0;
+        auto base = row.padded + (static_cast<int>(y0) + kPadBefore) * row.paddedWidth + static_cast<int>(x0) + kPadBefore;
+        auto top = base[0] + fx * (base[1] - base[0]);
+        auto bottom = base[row.paddedWidth] + fx * (base[row.paddedWidth + 1] - base[row.paddedWidth]);
+        dst[i] = top + fy * (bottom - top);
+    }
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx2,fma")]] void sampleRowAvx2(const SamplingRow &row, const float *xs, const float *ys, float *dst, int count)
+{
+    auto minCoord = _mm256_set1_ps(-1.f);
+    auto maxX = _mm256_set1_ps(row.maxX);
+    auto maxY = _mm256_set1_ps(row.maxY);
+    auto stride = _mm256_set1_epi32(row.paddedWidth);
+    auto padOffset = _mm256_set1_epi32(kPadBefore * row.paddedWidth + kPadBefore);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(xs + i), minCoord), maxX);
+        auto y = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(ys + i), minCoord), maxY);
+        auto x0 = _mm256_floor_ps(x);
+        auto y0 = _mm256_floor_ps(y);
+        auto fx = _mm256_sub_ps(x, x0);
+        auto fy = _mm256_sub_ps(y, y0);
+        auto index = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvtps_epi32(y0), stride),
+                                                       _mm256_cvtps_epi32(x0)), padOffset);
+        auto topLeft = _mm256_i32gather_ps(row.padded, index, 4);
+        auto topRight = _mm256_i32gather_ps(row.padded + 1, index, 4);
+        auto bottomLeft = _mm256_i32gather_ps(row.padded + row.paddedWidth, index, 4);
+        auto bottomRight = _mm256_i32gather_ps(row.padded + row.paddedWidth + 1, index, 4);
+        auto top = _mm256_fmadd_ps(fx, _mm256_sub_ps(topRight, topLeft), topLeft);
+        auto bottom = _mm256_fmadd_ps(fx, _mm256_sub_ps(bottomRight, bottomLeft), bottomLeft);
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(fy, _mm256_sub_ps(bottom, top), top));
+    }
+    sampleRowScalar(row, xs + i, ys + i, dst + i, count - i);
+}
+
+#endif
+
+void sampleRow(const SamplingRow &row, const float *xs, const float *ys, float *dst, int count)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (hasAvx2)
+        return sampleRowAvx2(row, xs, ys, dst, count);
+#endif
+    sampleRowScalar(row, xs, ys, dst, count);
+}
+
+// Separable gaussian blur of a width x height field, in place
+void smoothField(std::vector<float> &field, int width, int height, float sigma)
+{
+    auto radius = std::max(1, static_cast<int>(std::ceil(2.f * sigma)));
+    std::vector<float> weights(2 * radius + 1);
+    float sum {};
+    for (int i = -radius; i <= radius; i++)
+        sum += weights[i + radius] = std::exp(-0.5f * i * i / (sigma * sigma));
+    for (auto &weight : weights)
+        weight /= sum;
+    std::vector<float> tmp(field.size());
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            float value {};
+            for (int k = -radius; k <= radius; k++)
+                value += weights[k + radius] * field[y * width + std::clamp(x + k, 0, width - 1)];
+            tmp[y * width + x] = value;
+        }
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            float value {};
+            for (int k = -radius; k <= radius; k++)
+                value += weights[k + radius] * tmp[std::clamp(y + k, 0, height - 1) * width + x];
+            field[y * width + x] = value;
+        }
+}
+
+} // namespace
+
+Augmenter::Augmenter(int width, int height, AugmentationOptions options, std::uint64_t seed) :
+    width_ {width},
+    height_ {height},
+    options_ {options},
+    seed_ {seed}
+{
+    if (width_ <= 0 || height_ <= 0)
+        throw std::invalid_argument("Augmenter: image dimensions must be positive");
+    if (options_.minScale <= 0.f || options_.maxScale < options_.minScale)
+        throw std::invalid_argument("Augmenter: invalid scale range");
+}
+
+void Augmenter::augmentImage(const unsigned char *image, float *dst, std::uint64_t sampleIndex) const
+{
+    std::mt19937_64 gen {splitMix64(seed_ ^ splitMix64(sampleIndex))};
+    std::uniform_real_distribution<float> unit {-1.f, 1.f};
+    auto shiftX = options_.maxShift * unit(gen);
+    auto shiftY = options_.maxShift * unit(gen);
+    auto angle = options_.maxRotation * unit(gen);
+    auto scale = options_.minScale + (options_.maxScale - options_.minScale) * 0.5f * (unit(gen) + 1.f);
+
+    auto paddedWidth = width_ + kPadBefore + kPadAfter;
+    auto paddedHeight = height_ + kPadBefore + kPadAfter;
+    std::vector<float> padded(static_cast<std::size_t>(paddedWidth) * paddedHeight, 0.f);
+    for (int y = 0; y < height_; y++)
+        for (int x = 0; x < width_; x++)
+            padded[(y + kPadBefore) * paddedWidth + x + kPadBefore] = image[y * width_ + x] * (1.f / 255.f);
+
+    std::vector<float> displacementX, displacementY;
+    if (options_.elasticAlpha > 0.f)
+    {
+        for (auto field : {&displacementX, &displacementY})
+        {
+            field->resize(static_cast<std::size_t>(width_) * height_);
+            for (auto &value : *field)
+                value = unit(gen);
+            smoothField(*field, width_, height_, options_.elasticSigma);
+            // Normalize so that elasticAlpha is the largest displacement regardless of sigma
+            float maxMagnitude {1e-12f};
+            for (auto value : *field)
+                maxMagnitude = std::max(maxMagnitude, std::abs(value));
+            for (auto &value : *field)
+                value *= options_.elasticAlpha / maxMagnitude;
+        }
+    }
+
+    // Inverse mapping: output pixel -> source coordinate. The row-wise part is linear in x, so the
+    // coordinates of a whole row are produced by one add per pixel.
+    auto centerX = 0.5f * (width_ - 1);
+    auto centerY = 0.5f * (height_ - 1);
+    auto cosA = std::cos(angle) / scale;
+    auto sinA = std::sin(angle) / scale;
+    SamplingRow row {padded.data(), paddedWidth, static_cast<float>(width_), static_cast<float>(height_)};
+    std::vector<float> xs(width_), ys(width_);
+    for (int y = 0; y < height_; y++)
+    {
+        auto relY = y - centerY - shiftY;
+        auto relX = -centerX - shiftX;
+        auto x0 = cosA * relX + sinA * relY + centerX;
+        auto y0 = -sinA * relX + cosA * relY + centerY;
+        for (int x = 0; x < width_; x++)
+        {
+            xs[x] = x0 + cosA * x;
+            ys[x] = y0 - sinA * x;
+        }
+        if (!displacementX.empty())
+            for (int x = 0; x < width_; x++)
+            {
+                xs[x] += displacementX[y * width_ + x];
+                ys[x] += displacementY[y * width_ + x];
+            }
+        sampleRow(row, xs.data(), ys.data(), dst + y * width_, width_);
+    }
+
+    if (options_.noiseStddev > 0.f)
+    {
+        std::normal_distribution<float> noise {0.f, options_.noiseStddev};
+        for (int i = 0; i < width_ * height_; i++)
+            dst[i] = std::clamp(dst[i] + noise(gen), 0.f, 1.f);
+    }
+}
+
+void Augmenter::augmentBatch(const unsigned char *images, std::size_t numImages, float *dst,
+                             std::uint64_t firstSampleIndex, runtime::ThreadPool *pool) const
+{
+    auto imageSize = static_cast<std::size_t>(width_) * height_;
+    auto body = [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            augmentImage(images + i * imageSize, dst + i * imageSize, firstSampleIndex + i);
+    };
+    if (pool)
+        pool->parallelFor(0, numImages, body);
+    else
+        body(0, numImages);
+}
+
+} // dataset
+} // yt
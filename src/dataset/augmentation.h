@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yt {
+namespace runtime {
+class ThreadPool;
+} // runtime
+
+namespace dataset {
+
+struct AugmentationOptions
+{
+    float maxShift {2.f};
+    float maxRotation {0.26f};
+    float minScale {0.9f};
+    float maxScale {1.1f};
+    // Elastic distortion: displacement magnitude in pixels (0 disables) and smoothness of the field
+    float elasticAlpha {0.f};
+    float elasticSigma {4.f};
+    float noiseStddev {0.f};
+};
+
+// Random affine shift/rotation/scale, elastic distortion and additive noise for 8-bit grayscale
+// images as returned by Mnist::loadImages, written as floats in [0, 1] straight into a batch.
+// Every sample draws from its own generator seeded by (seed, sampleIndex), so results don't depend
+// on how samples are spread over threads.
+class Augmenter
+{
+public:
+    Augmenter(int width, int height, AugmentationOptions options, std::uint64_t seed);
+
+    void augmentImage(const unsigned char *image, float *dst, std::uint64_t sampleIndex) const;
+    // Image i of images gets sample index firstSampleIndex + i and is written to dst + i * width * height
+    void augmentBatch(const unsigned char *images, std::size_t numImages, float *dst,
+                      std::uint64_t firstSampleIndex, runtime::ThreadPool *pool = nullptr) const;
+
+private:
+    int width_;
+    int height_;
+    AugmentationOptions options_;
+    std::uint64_t seed_;
+};
+
+} // dataset
+} // yt
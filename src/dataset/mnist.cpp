@@ -48,6 +48,19 @@ std::vector<unsigned char> Mnist::loadLabels(std::size_t numLabels)
     return result;
 }
 
+void Mnist::seek(std::size_t index)
+{
+    if (index > static_cast<std::size_t>(numItems_))
+        throw std::out_of_range("MNIST Read Error: Requested position exceeds number of items in the dataset");
+    auto imageSize = static_cast<std::streamoff>(width_) * height_;
+    images_.clear();
+    labels_.clear();
+    images_.seekg(kImagesHeaderSize + static_cast<std::streamoff>(index) * imageSize);
+    labels_.seekg(kLabelsHeaderSize + static_cast<std::streamoff>(index));
+    if (!images_.good() || !labels_.good())
+        throw std::runtime_error("I/O error accured during seeking in dataset");
+}
+
 int Mnist::imageWidth() const
 {
     return width_;
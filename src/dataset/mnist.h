@@ -12,6 +12,8 @@ public:
     Mnist(std::istream& images, std::istream& labels);
     std::vector<unsigned char> loadImages(std::size_t numImages);
     std::vector<unsigned char> loadLabels(std::size_t numImages);
+    // Positions both streams at item index, e.g. the start of a worker's shard
+    void seek(std::size_t index);
     int imageWidth() const;
     int imageHeight() const;
     int size() const;
@@ -19,6 +21,8 @@ public:
 private:
     static constexpr int kImagesMagicNumber = 0x00000803;
     static constexpr int kLabelsMagicNumber = 0x00000801;
+    static constexpr std::streamoff kImagesHeaderSize = 16;
+    static constexpr std::streamoff kLabelsHeaderSize = 8;
 
     std::istream &images_;
     std::istream &labels_;
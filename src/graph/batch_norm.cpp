@@ -0,0 +1,53 @@
+#include "batch_norm.h"
+#include <kernels/layers.h>
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+BatchNorm::BatchNorm(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &scale,
+                     const TensorDescriptor::WeakPtr &shift, const TensorDescriptor::WeakPtr &mean,
+                     const TensorDescriptor::WeakPtr &variance, float epsilon, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{input, scale, shift, mean, variance}),
+        name.empty() ? "batch_norm_" + std::to_string(genUniqueNameSuffix()) : name
+    },
+    epsilon_ {epsilon}
+{
+    auto inputPtr = input.lock();
+    if (!inputPtr || inputPtr->shape().size() < 2)
+        throwException(name_ + ": expected [N, C, ...] input");
+    for (std::size_t i = 1; i < inputs_.size(); i++)
+    {
+        auto parameter = inputs_[i].lock();
+        if (!parameter || parameter->shape() != Shape{inputPtr->shape()[1]})
+            throwException(name_ + ": parameter #" + std::to_string(i) + " must hold one value per channel");
+    }
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, inputPtr->shape(), this)};
+}
+
+float BatchNorm::epsilon() const
+{
+    return epsilon_;
+}
+
+Node::Kernel BatchNorm::kernel(const std::vector<Shape> &) const
+{
+    return [epsilon = epsilon_](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::batchNorm(*inputs[0], *inputs[1], *inputs[2], *inputs[3], *inputs[4], epsilon, *outputs[0]);
+    };
+}
+
+double BatchNorm::flops(const std::vector<Shape> &inputShapes) const
+{
+    // The kernel folds the statistics into one multiply-add per element
+    return 2. * static_cast<double>(inputShapes[0].numElements());
+}
+
+std::vector<Layout> BatchNorm::supportedLayouts() const
+{
+    return {Layout::nChw8c, Layout::nhwc, Layout::nchw};
+}
+
+} // graph
+} // yt_ml_toolkit
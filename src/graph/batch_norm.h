@@ -0,0 +1,26 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// Inference batch normalization over axis 1: (x - mean) / sqrt(variance + epsilon) * scale + shift
+class BatchNorm : public Node
+{
+public:
+    BatchNorm(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &scale,
+              const TensorDescriptor::WeakPtr &shift, const TensorDescriptor::WeakPtr &mean,
+              const TensorDescriptor::WeakPtr &variance, float epsilon = 1e-5f,
+              const std::string &name = std::string{});
+    float epsilon() const;
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+    std::vector<Layout> supportedLayouts() const override;
+
+private:
+    float epsilon_;
+};
+
+} // graph
+} // yt_ml_toolkit
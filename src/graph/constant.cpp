@@ -0,0 +1,30 @@
+#include "constant.h"
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+Constant::Constant(Tensor value, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{}),
+        name.empty() ? "constant_" + std::to_string(genUniqueNameSuffix()) : name
+    },
+    value_ {value.contiguous()}
+{
+    if (value_.empty())
+        throwException(name_ + ": constant value has no storage");
+    outputs_ = {std::make_shared<TensorDescriptor>(value_.dataType(), value_.shape(), this)};
+}
+
+Tensor &Constant::value()
+{
+    return value_;
+}
+
+const Tensor &Constant::value() const
+{
+    return value_;
+}
+
+} // graph
+} // yt_ml_toolkit
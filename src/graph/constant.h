@@ -0,0 +1,22 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// The execution plan binds value() directly, like a graph input; nothing is copied per run.
+// A strided view passed in is made dense once here, since kernels read value() as plain storage.
+class Constant : public Node
+{
+public:
+    explicit Constant(Tensor value, const std::string &name = std::string{});
+    Tensor &value();
+    const Tensor &value() const;
+
+private:
+    Tensor value_;
+};
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,68 @@
+#include "conv2d.h"
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+Conv2D::Conv2D(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &weights,
+               const TensorDescriptor::WeakPtr &bias, kernels::Conv2DParams params, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{input, weights, bias}),
+        name.empty() ? "conv2d_" + std::to_string(genUniqueNameSuffix()) : name
+    },
+    params_ {params}
+{
+    auto inputPtr = input.lock();
+    auto weightsPtr = weights.lock();
+    auto biasPtr = bias.lock();
+    if (!inputPtr || !weightsPtr || !biasPtr)
+        throwException(name_ + ": inputs are not available");
+    const auto &inShape = inputPtr->shape();
+    const auto &wShape = weightsPtr->shape();
+    if (inShape.size() != 4 || wShape.size() != 4 || inShape[1] != wShape[1] || biasPtr->shape() != Shape{wShape[0]})
+        throwException(name_ + ": expected NCHW input, [O, C, KH, KW] weights and [O] bias");
+    Shape outShape {inShape[0], wShape[0],
+                    kernels::convOutputSize(inShape[2], wShape[2], params_.stride, params_.padding),
+                    kernels::convOutputSize(inShape[3], wShape[3], params_.stride, params_.padding)};
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, outShape, this)};
+}
+
+const kernels::Conv2DParams &Conv2D::params() const
+{
+    return params_;
+}
+
+Node::Kernel Conv2D::kernel(const std::vector<Shape> &inputShapes) const
+{
+    // Blocked inputs don't use gemm
+    auto tiling = kernels::gemmTilings().front();
+    if (outputs_[0]->layout() == Layout::nchw)
+    {
+        const auto &in = inputShapes[0];
+        const auto &w = inputShapes[1];
+        auto numPixels = kernels::convOutputSize(in[2], w[2], params_.stride, params_.padding) *
+                         kernels::convOutputSize(in[3], w[3], params_.stride, params_.padding);
+        tiling = kernels::tunedGemmTiling(w[0], numPixels, w[1] * w[2] * w[3]);
+    }
+    return [params = params_, tiling](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::conv2d(*inputs[0], *inputs[1], *inputs[2], params, *outputs[0], tiling);
+    };
+}
+
+double Conv2D::flops(const std::vector<Shape> &inputShapes) const
+{
+    const auto &in = inputShapes[0];
+    const auto &w = inputShapes[1];
+    auto outputPixels = static_cast<double>(kernels::convOutputSize(in[2], w[2], params_.stride, params_.padding) *
+                                            kernels::convOutputSize(in[3], w[3], params_.stride, params_.padding));
+    auto outputs = static_cast<double>(in[0] * w[0]) * outputPixels;
+    return outputs * (2. * w[1] * w[2] * w[3] + 1.);
+}
+
+std::vector<Layout> Conv2D::supportedLayouts() const
+{
+    return {Layout::nChw8c, Layout::nchw};
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "node_base.h"
+#include <kernels/layers.h>
+
+namespace yt {
+namespace graph {
+
+// NCHW input, weights [O, C, KH, KW], bias [O]
+class Conv2D : public Node
+{
+public:
+    Conv2D(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &weights,
+           const TensorDescriptor::WeakPtr &bias, kernels::Conv2DParams params = {},
+           const std::string &name = std::string{});
+    const kernels::Conv2DParams &params() const;
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+    std::vector<Layout> supportedLayouts() const override;
+
+private:
+    kernels::Conv2DParams params_;
+};
+
+} // graph
+} // yt_ml_toolkit
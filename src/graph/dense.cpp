@@ -0,0 +1,44 @@
+#include "dense.h"
+#include <kernels/layers.h>
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+Dense::Dense(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &weights,
+             const TensorDescriptor::WeakPtr &bias, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{input, weights, bias}),
+        name.empty() ? "dense_" + std::to_string(genUniqueNameSuffix()) : name
+    }
+{
+    auto inputPtr = input.lock();
+    auto weightsPtr = weights.lock();
+    auto biasPtr = bias.lock();
+    if (!inputPtr || !weightsPtr || !biasPtr)
+        throwException(name_ + ": inputs are not available");
+    const auto &inShape = inputPtr->shape();
+    const auto &wShape = weightsPtr->shape();
+    if (inShape.size() != 2 || wShape.size() != 2 || inShape[1] != wShape[0] || biasPtr->shape() != Shape{wShape[1]})
+        throwException(name_ + ": expected input [N, K], weights [K, M] and bias [M]");
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, Shape{inShape[0], wShape[1]}, this)};
+}
+
+Node::Kernel Dense::kernel(const std::vector<Shape> &inputShapes) const
+{
+    auto tiling = kernels::tunedGemmTiling(inputShapes[0][0], inputShapes[1][1], inputShapes[0][1]);
+    return [tiling](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::dense(*inputs[0], *inputs[1], *inputs[2], *outputs[0], tiling);
+    };
+}
+
+double Dense::flops(const std::vector<Shape> &inputShapes) const
+{
+    // Multiply-add per weight and row, plus the bias
+    auto rows = static_cast<double>(inputShapes[0][0]);
+    auto units = static_cast<double>(inputShapes[1][1]);
+    return rows * units * (2. * inputShapes[0][1] + 1.);
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// output[N, M] = input[N, K] * weights[K, M] + bias[M]
+class Dense : public Node
+{
+public:
+    Dense(const TensorDescriptor::WeakPtr &input, const TensorDescriptor::WeakPtr &weights,
+          const TensorDescriptor::WeakPtr &bias, const std::string &name = std::string{});
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+};
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,87 @@
+#include "elementwise.h"
+#include <kernels/elementwise.h>
+#include <throw_exception.h>
+#include <algorithm>
+
+namespace yt {
+namespace graph {
+
+namespace {
+
+// Broadcast of declared shapes: a dynamic dimension stays dynamic and is checked once it is bound
+Shape declaredBroadcast(const std::string &name, const Shape &a, const Shape &b)
+{
+    Shape result(std::max(a.size(), b.size()));
+    for (std::size_t i = 0; i < result.size(); i++)
+    {
+        auto x = i < a.size() ? a[a.size() - 1 - i] : 1;
+        auto y = i < b.size() ? b[b.size() - 1 - i] : 1;
+        auto &dim = result[result.size() - 1 - i];
+        if (x == kDynamicDim || y == kDynamicDim)
+            dim = kDynamicDim;
+        else if (x == y || y == 1)
+            dim = x;
+        else if (x == 1)
+            dim = y;
+        else
+            throwException(name + ": shapes cannot be broadcast");
+    }
+    return result;
+}
+
+} // namespace
+
+Add::Add(const TensorDescriptor::WeakPtr &a, const TensorDescriptor::WeakPtr &b, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{a, b}),
+        name.empty() ? "add_" + std::to_string(genUniqueNameSuffix()) : name
+    }
+{
+    auto aPtr = a.lock();
+    auto bPtr = b.lock();
+    if (!aPtr || !bPtr)
+        throwException(name_ + ": input is not available");
+    if (aPtr->dataType() != fp32 || bPtr->dataType() != fp32)
+        throwException(name_ + ": expected fp32 inputs");
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, declaredBroadcast(name_, aPtr->shape(), bPtr->shape()), this)};
+}
+
+std::vector<Shape> Add::inferOutputShapes(const std::vector<Shape> &inputShapes) const
+{
+    return {kernels::broadcastShapes(inputShapes[0], inputShapes[1])};
+}
+
+Node::Kernel Add::kernel(const std::vector<Shape> &) const
+{
+    return [](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::add(*inputs[0], *inputs[1], *outputs[0]);
+    };
+}
+
+double Add::flops(const std::vector<Shape> &inputShapes) const
+{
+    return static_cast<double>(kernels::broadcastShapes(inputShapes[0], inputShapes[1]).numElements());
+}
+
+bool Add::acceptsStridedInputs() const
+{
+    return true;
+}
+
+std::vector<Layout> Add::supportedLayouts() const
+{
+    // Without broadcasting the sum runs flat over the storage, so any layout shared by both operands works
+    auto a = inputs_[0].lock();
+    auto b = inputs_[1].lock();
+    if (a && b && a->shape() == b->shape())
+        return {Layout::nChw8c, Layout::nhwc, Layout::nchw};
+    return {Layout::nchw};
+}
+
+bool Add::inputsShareLayout() const
+{
+    return true;
+}
+
+} // graph
+} // yt_ml_toolkit
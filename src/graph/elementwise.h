@@ -0,0 +1,23 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// output = a + b with numpy-style broadcasting. Broadcast operands and strided views are read in
+// place through zero strides, never expanded. Operands of one shape may also be nhwc or nChw8c.
+class Add : public Node
+{
+public:
+    Add(const TensorDescriptor::WeakPtr &a, const TensorDescriptor::WeakPtr &b, const std::string &name = std::string{});
+    std::vector<Shape> inferOutputShapes(const std::vector<Shape> &inputShapes) const override;
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+    bool acceptsStridedInputs() const override;
+    std::vector<Layout> supportedLayouts() const override;
+    bool inputsShareLayout() const override;
+};
+
+} // graph
+} // yt_ml_toolkit
@@ -1,39 +1,80 @@
 #include "node_base.h"
+#include "topological_order.h"
+#include <throw_exception.h>
+#include <algorithm>
 
 namespace yt {
 namespace graph {
 
-unsigned Node::uniqueNameSuffix {};
+std::atomic<unsigned> Node::uniqueNameSuffix {};
 
 Node::Node(const std::vector<TensorDescriptor::WeakPtr> &inputs, const std::string &name) :
     name_ {name},
     inputs_ {inputs.begin(), inputs.end()}
 {
-    for (auto &input : inputs_)
-        if (!input.expired())
-            input.lock()->consumers().push_back(this);
+    attachToInputs();
 }
 
 Node::Node(std::vector<TensorDescriptor::WeakPtr> &&inputs, const std::string &name) :
     name_ {name},
     inputs_ {std::move(inputs)}
 {
-    for (auto &input : inputs_)
-        if (!input.expired())
-            input.lock()->consumers().push_back(this);
+    attachToInputs();
 }
 
 Node::~Node()
 {
+    std::vector<TensorDescriptor::Ptr> lockedInputs;
     for (auto input : inputs_)
+        if (auto descriptor = input.lock())
+            lockedInputs.push_back(std::move(descriptor));
+    std::lock_guard<std::mutex> lock {TopologicalOrder::instance().mutex()};
+    for (auto &input : lockedInputs)
+    {
+        auto &consumers = input->consumers();
+        consumers.erase(std::remove_if(consumers.begin(), consumers.end(), [this](Node* node) { return node == this; }),
+                consumers.end());
+    }
+    TopologicalOrder::instance().erase(this);
+}
+
+void Node::attachToInputs()
+{
+    std::lock_guard<std::mutex> lock {TopologicalOrder::instance().mutex()};
+    TopologicalOrder::instance().insert(this);
+    for (auto &input : inputs_)
+        if (auto descriptor = input.lock())
+            descriptor->consumers().push_back(this);
+}
+
+void Node::replaceInput(std::size_t index, const TensorDescriptor::WeakPtr &input)
+{
+    if (index >= inputs_.size())
+        throwException(name_ + ": input #" + std::to_string(index) + " doesn't exist");
+    auto newInput = input.lock();
+    if (!newInput)
+        throwException(name_ + ": replacement for input #" + std::to_string(index) + " is not available");
+    auto oldInput = inputs_[index].lock();
+    auto &order = TopologicalOrder::instance();
+    std::lock_guard<std::mutex> lock {order.mutex()};
+    if (newInput->producer())
+        order.addEdge(newInput->producer(), this);
+    if (oldInput)
     {
-        if (!input.expired())
-        {
-            auto &consumers = input.lock()->consumers();
-            consumers.erase(std::remove_if(consumers.begin(), consumers.end(), [this](Node* node) { return node == this; }),
-                    consumers.end());
-        }
+        auto &consumers = oldInput->consumers();
+        auto it = std::find(consumers.begin(), consumers.end(), this);
+        if (it != consumers.end())
+            consumers.erase(it);
     }
+    newInput->consumers().push_back(this);
+    inputs_[index] = newInput;
+}
+
+std::size_t Node::topologicalIndex() const
+{
+    auto &order = TopologicalOrder::instance();
+    std::lock_guard<std::mutex> lock {order.mutex()};
+    return order.index(this);
 }
 
 const std::string &Node::name() const
@@ -41,6 +82,11 @@ const std::string &Node::name() const
     return name_;
 }
 
+std::size_t Node::id() const
+{
+    return id_;
+}
+
 Node::OutputsList &Node::outputs()
 {
     return outputs_;
@@ -71,9 +117,76 @@ Node::operator TensorDescriptor::Ptr()
     return outputs_.front();
 }
 
-TensorDescriptor::TensorDescriptor(DataType dtype, Shape shape, Node *producer) :
+std::vector<Shape> Node::inferOutputShapes(const std::vector<Shape> &inputShapes) const
+{
+    if (inputShapes.size() != inputs_.size())
+        throwException(name_ + ": expected " + std::to_string(inputs_.size()) + " input shapes, got " +
+                       std::to_string(inputShapes.size()));
+    std::size_t batch {kDynamicDim};
+    for (std::size_t i = 0; i < inputs_.size() && batch == kDynamicDim; i++)
+    {
+        auto input = inputs_[i].lock();
+        if (!input)
+            continue;
+        const auto &declared = input->shape();
+        for (std::size_t dim = 0; dim < declared.size() && dim < inputShapes[i].size(); dim++)
+            if (declared[dim] == kDynamicDim)
+            {
+                batch = inputShapes[i][dim];
+                break;
+            }
+    }
+    std::vector<Shape> result;
+    result.reserve(outputs_.size());
+    for (const auto &output : outputs_)
+    {
+        auto shape = output->shape();
+        for (auto &dim : shape)
+            if (dim == kDynamicDim)
+            {
+                if (batch == kDynamicDim)
+                    throwException(name_ + ": cannot resolve dynamic output dimension");
+                dim = batch;
+            }
+        result.push_back(std::move(shape));
+    }
+    return result;
+}
+
+Node::Kernel Node::kernel(const std::vector<Shape> &) const
+{
+    return {};
+}
+
+double Node::flops(const std::vector<Shape> &) const
+{
+    return 0.;
+}
+
+std::vector<Layout> Node::supportedLayouts() const
+{
+    return {Layout::nchw};
+}
+
+bool Node::inputsShareLayout() const
+{
+    return false;
+}
+
+std::optional<ViewGeometry> Node::outputView(const ViewGeometry &) const
+{
+    return std::nullopt;
+}
+
+bool Node::acceptsStridedInputs() const
+{
+    return false;
+}
+
+TensorDescriptor::TensorDescriptor(DataType dtype, Shape shape, Node *producer, Layout layout) :
     dtype_ {dtype},
     shape_ {shape},
+    layout_ {layout},
     producer_ {producer}
 {
 }
@@ -100,6 +213,26 @@ const Shape &TensorDescriptor::shape() const
     return shape_;
 }
 
+Layout TensorDescriptor::layout() const
+{
+    return layout_;
+}
+
+void TensorDescriptor::setLayout(Layout layout)
+{
+    layout_ = layout;
+}
+
+bool TensorDescriptor::isView() const
+{
+    return view_;
+}
+
+void TensorDescriptor::setView(bool view)
+{
+    view_ = view;
+}
+
 TensorDescriptor::NodesList &TensorDescriptor::consumers()
 {
     return consumers_;
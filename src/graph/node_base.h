@@ -1,7 +1,10 @@
 #pragma once
 
 #include "shape.h"
+#include "tensor.h"
+#include <atomic>
 #include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -10,6 +13,14 @@ namespace graph {
 
 class Node;
 
+// Position of a tensor's elements inside some storage, in elements
+struct ViewGeometry
+{
+    Shape shape {};
+    Strides strides {};
+    std::ptrdiff_t offset {};
+};
+
 class TensorDescriptor
 {
 public:
@@ -17,10 +28,17 @@ public:
     using WeakPtr = std::weak_ptr<TensorDescriptor>;
     using NodesList = std::vector<Node*>;
 
-    TensorDescriptor(DataType dtype, Shape shape, Node* producer);
+    TensorDescriptor(DataType dtype, Shape shape, Node* producer, Layout layout = Layout::nchw);
     ~TensorDescriptor();
     DataType dataType() const;
     const Shape &shape() const;
+    // Physical layout the producer writes; set by assignLayouts()
+    Layout layout() const;
+    void setLayout(Layout layout);
+    // Aliases the storage of its producer's input #0 instead of owning memory; the concrete strides
+    // are resolved by the execution plan, see Node::outputView()
+    bool isView() const;
+    void setView(bool view);
     NodesList &consumers();
     const NodesList &consumers() const;
     const Node* producer() const;
@@ -29,6 +47,8 @@ public:
 private:
     DataType dtype_;
     Shape shape_;
+    Layout layout_;
+    bool view_ {};
     Node* producer_;
     NodesList consumers_;
 };
@@ -39,19 +59,45 @@ public:
     using OutputsList = std::vector<TensorDescriptor::Ptr>;
     using InputsList = std::vector<TensorDescriptor::WeakPtr>;
     using Ptr = std::shared_ptr<Node>;
+    using Kernel = std::function<void(const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs)>;
 
     explicit Node(const std::vector<TensorDescriptor::WeakPtr> &inputs, const std::string &name);
     explicit Node(std::vector<TensorDescriptor::WeakPtr> &&inputs, const std::string &name);
     virtual ~Node();
     const std::string &name() const;
+    // Dense id of a live node: ids of destroyed nodes are handed out again, so arrays indexed
+    // by id stay as small as the set of live nodes
+    std::size_t id() const;
     OutputsList& outputs();
     const OutputsList &outputs() const;
     InputsList& inputs();
     const InputsList &inputs() const;
+    // Rewires input #index to another tensor, keeping consumer lists and the topological order in sync
+    void replaceInput(std::size_t index, const TensorDescriptor::WeakPtr &input);
+    // Index in an order maintained across graph edits: a producer always has a lower index than its consumers
+    std::size_t topologicalIndex() const;
     virtual operator TensorDescriptor::Ptr();
     virtual operator TensorDescriptor::WeakPtr();
+
+    // Concrete output shapes for concrete input shapes. The default resolves kDynamicDim in the
+    // declared output shapes with the batch size bound to the first dynamic input dimension.
+    virtual std::vector<Shape> inferOutputShapes(const std::vector<Shape> &inputShapes) const;
+    // Kernel computing the outputs for the given concrete input shapes; empty for nodes without computation
+    virtual Kernel kernel(const std::vector<Shape> &inputShapes) const;
+    // Arithmetic operations performed by the kernel for the given concrete input shapes; 0 for pure data movement
+    virtual double flops(const std::vector<Shape> &inputShapes) const;
+    // Layouts the kernel accepts for input #0 and writes for output #0, fastest first; all other inputs
+    // and outputs are always nchw, unless inputsShareLayout()
+    virtual std::vector<Layout> supportedLayouts() const;
+    // Whether inputs after #0 are read in the layout of input #0 instead of nchw
+    virtual bool inputsShareLayout() const;
+    // Nodes with a view output: where output #0 lies inside the storage of input #0 for the given input
+    // geometry, or std::nullopt if it cannot be expressed over those strides and the kernel must copy
+    virtual std::optional<ViewGeometry> outputView(const ViewGeometry &input) const;
+    // Whether the kernel reads strided views; other kernels get non-contiguous inputs copied to scratch first
+    virtual bool acceptsStridedInputs() const;
 protected:
-    static unsigned genUniqueNameSuffix() { return uniqueNameSuffix++; }
+    static unsigned genUniqueNameSuffix() { return uniqueNameSuffix.fetch_add(1, std::memory_order_relaxed); }
 
 protected:
     std::string name_;
@@ -60,7 +106,13 @@ protected:
     OutputsList outputs_;
 
 private:
-    static unsigned uniqueNameSuffix;
+    friend class TopologicalOrder;
+
+    void attachToInputs();
+
+    static std::atomic<unsigned> uniqueNameSuffix;
+    std::size_t id_ {};
+    std::size_t topologicalIndex_ {};
 };
 
 } // graph
@@ -0,0 +1,43 @@
+#include "node_index.h"
+#include <algorithm>
+
+namespace yt {
+namespace graph {
+
+NodeIndex::NodeIndex(const Nodes &nodes) :
+    nodes_ {nodes}
+{
+    if (nodes_.empty())
+        return;
+    auto [minIt, maxIt] = std::minmax_element(nodes_.begin(), nodes_.end(),
+                                              [](const Node::Ptr &a, const Node::Ptr &b) { return a->id() < b->id(); });
+    minId_ = (*minIt)->id();
+    byId_.assign((*maxIt)->id() - minId_ + 1, nullptr);
+    byName_.reserve(nodes_.size());
+    for (auto &node : nodes_)
+    {
+        byId_[node->id() - minId_] = node.get();
+        byName_.emplace(node->name(), node.get());
+    }
+}
+
+Node *NodeIndex::find(std::string_view name) const
+{
+    auto found = byName_.find(name);
+    return found == byName_.end() ? nullptr : found->second;
+}
+
+Node *NodeIndex::find(std::size_t id) const
+{
+    if (id < minId_ || id - minId_ >= byId_.size())
+        return nullptr;
+    return byId_[id - minId_];
+}
+
+std::size_t NodeIndex::size() const
+{
+    return nodes_.size();
+}
+
+} // graph
+} // yt_ml_toolkit
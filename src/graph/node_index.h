@@ -0,0 +1,29 @@
+#pragma once
+
+#include "traversal.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace yt {
+namespace graph {
+
+// Constant-time lookup of the nodes of one graph by id or by name. Keys view the nodes' own
+// name strings, so the index holds no copies; with duplicate names the first node wins.
+class NodeIndex
+{
+public:
+    explicit NodeIndex(const Nodes &nodes);
+    Node *find(std::string_view name) const;
+    Node *find(std::size_t id) const;
+    std::size_t size() const;
+
+private:
+    Nodes nodes_;
+    std::unordered_map<std::string_view, Node*> byName_ {};
+    std::vector<Node*> byId_ {};
+    std::size_t minId_ {};
+};
+
+} // graph
+} // yt_ml_toolkit
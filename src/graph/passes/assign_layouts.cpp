@@ -0,0 +1,105 @@
+#include "assign_layouts.h"
+#include "rewrite.h"
+#include <graph/reorder.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace yt {
+namespace graph {
+
+namespace {
+
+// Below this many FLOPs per output element a node is memory-bound and not worth a reorder of its own
+constexpr double kReorderWorthFlopsPerElement = 16.;
+
+Shape withUnitBatch(Shape shape)
+{
+    for (auto &dim : shape)
+        if (dim == kDynamicDim)
+            dim = 1;
+    return shape;
+}
+
+double flopsPerElement(const Node &node)
+{
+    std::vector<Shape> shapes;
+    for (auto &input : node.inputs())
+        shapes.push_back(withUnitBatch(input.lock()->shape()));
+    auto elements = withUnitBatch(node.outputs().front()->shape()).numElements();
+    return elements ? node.flops(shapes) / static_cast<double>(elements) : 0.;
+}
+
+Layout chooseLayout(const Node &node)
+{
+    auto activation = node.inputs().front().lock();
+    auto supported = node.supportedLayouts();
+    if (node.outputs().empty() || supported.empty() || activation->shape().size() != 4 ||
+        activation->dataType() != fp32)
+        return Layout::nchw;
+    bool followsInput = std::find(supported.begin(), supported.end(), activation->layout()) != supported.end();
+    if (followsInput && flopsPerElement(node) < kReorderWorthFlopsPerElement)
+        return activation->layout();
+    return supported.front();
+}
+
+} // namespace
+
+LayoutAssignment assignLayouts(const Nodes &inputs, const Nodes &outputs)
+{
+    LayoutAssignment result;
+    std::map<std::pair<const TensorDescriptor*, Layout>, std::shared_ptr<Reorder>> reorderOf;
+    auto require = [&](Node &consumer, std::size_t index, Layout layout) {
+        auto input = consumer.inputs()[index].lock();
+        if (input->layout() == layout)
+            return;
+        auto &reorder = reorderOf[{input.get(), layout}];
+        if (!reorder)
+        {
+            reorder = std::make_shared<Reorder>(input, layout);
+            result.reorders.push_back(reorder);
+        }
+        consumer.replaceInput(index, reorder->outputs().front());
+    };
+
+    for (auto &node : traverseInTopologicalOrder(inputs, outputs))
+    {
+        // Existing reorders read any layout and keep their target
+        if (node->inputs().empty() || std::dynamic_pointer_cast<Reorder>(node))
+            continue;
+        auto layout = chooseLayout(*node);
+        require(*node, 0, layout);
+        for (std::size_t i = 1; i < node->inputs().size(); i++)
+            require(*node, i, node->inputsShareLayout() ? layout : Layout::nchw);
+        for (std::size_t i = 0; i < node->outputs().size(); i++)
+            node->outputs()[i]->setLayout(i ? Layout::nchw : layout);
+    }
+
+    for (auto &node : traverseInTopologicalOrder(inputs, outputs))
+    {
+        auto reorder = std::dynamic_pointer_cast<Reorder>(node);
+        if (!reorder)
+            continue;
+        auto source = reorder->inputs().front().lock();
+        auto previous = dynamic_cast<Reorder*>(source->producer());
+        auto origin = previous ? previous->inputs().front().lock() : source;
+        if (origin->layout() == reorder->layout())
+        {
+            replaceAllUses(reorder->outputs().front(), origin);
+            result.cancelled++;
+        }
+        else if (previous)
+        {
+            reorder->replaceInput(0, origin);
+            result.cancelled++;
+        }
+    }
+
+    result.reorders.erase(std::remove_if(result.reorders.begin(), result.reorders.end(), [](const Node::Ptr &node) {
+        return node->outputs().front()->consumers().empty();
+    }), result.reorders.end());
+    return result;
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <graph/traversal.h>
+
+namespace yt {
+namespace graph {
+
+struct LayoutAssignment
+{
+    // Reorder nodes created by the pass that are still in use. Graph edges are weak references,
+    // so the caller keeps these alive for as long as the graph is used.
+    Nodes reorders {};
+    // Reorders removed because they undid the previous reorder or did nothing, or merged into one
+    std::size_t cancelled {};
+};
+
+// Gives every node with a choice of layouts (see Node::supportedLayouts) its fastest one and sets the
+// layout of its output descriptor. Nodes doing only a few FLOPs per output element instead keep the
+// layout their input arrives in when they support it, since a reorder would cost more than it saves.
+// Reorder nodes are inserted only where a tensor's layout differs from what a consumer reads (one per
+// tensor and target layout), graph inputs and outputs stay nchw, and chains of reorders are then
+// collapsed. Run it before compiling an Executor.
+LayoutAssignment assignLayouts(const Nodes &inputs, const Nodes &outputs);
+
+} // graph
+} // yt_ml_toolkit
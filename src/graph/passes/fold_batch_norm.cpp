@@ -0,0 +1,92 @@
+#include "fold_batch_norm.h"
+#include "rewrite.h"
+#include <graph/batch_norm.h>
+#include <graph/constant.h>
+#include <graph/conv2d.h>
+#include <graph/dense.h>
+#include <kernels/convert.h>
+#include <cmath>
+#include <vector>
+
+namespace yt {
+namespace graph {
+
+namespace {
+
+Constant *exclusiveConstant(const TensorDescriptor::WeakPtr &input)
+{
+    auto descriptor = input.lock();
+    if (!descriptor || descriptor->consumers().size() != 1)
+        return nullptr;
+    return dynamic_cast<Constant*>(descriptor->producer());
+}
+
+bool readConstant(const TensorDescriptor::WeakPtr &input, std::vector<float> &values)
+{
+    auto descriptor = input.lock();
+    auto constant = descriptor ? dynamic_cast<Constant*>(descriptor->producer()) : nullptr;
+    if (!constant)
+        return false;
+    values.resize(constant->value().numElements());
+    kernels::loadAsFloat(constant->value(), 0, values.size(), values.data());
+    return true;
+}
+
+Tensor fromFloat(const std::vector<float> &values, const Tensor &like)
+{
+    Tensor result {like.dataType(), like.shape()};
+    kernels::storeFromFloat(values.data(), values.size(), result, 0);
+    return result;
+}
+
+} // namespace
+
+std::size_t foldBatchNorm(const Nodes &inputs, const Nodes &outputs)
+{
+    std::size_t folded {};
+    for (auto &node : traverseInTopologicalOrder(inputs, outputs))
+    {
+        auto batchNorm = std::dynamic_pointer_cast<BatchNorm>(node);
+        if (!batchNorm)
+            continue;
+        auto layerOutput = batchNorm->inputs()[0].lock();
+        if (!layerOutput || layerOutput->consumers().size() != 1)
+            continue;
+        auto layer = layerOutput->producer();
+        bool isDense = dynamic_cast<Dense*>(layer) != nullptr;
+        if (!isDense && !dynamic_cast<Conv2D*>(layer))
+            continue;
+        auto weights = exclusiveConstant(layer->inputs()[1]);
+        auto bias = exclusiveConstant(layer->inputs()[2]);
+        std::vector<float> scale, shift, mean, variance;
+        if (!weights || !bias || !readConstant(batchNorm->inputs()[1], scale) || !readConstant(batchNorm->inputs()[2], shift) ||
+            !readConstant(batchNorm->inputs()[3], mean) || !readConstant(batchNorm->inputs()[4], variance))
+            continue;
+
+        auto channels = scale.size();
+        std::vector<float> multiplier(channels);
+        for (std::size_t c = 0; c < channels; c++)
+            multiplier[c] = scale[c] / std::sqrt(variance[c] + batchNorm->epsilon());
+
+        std::vector<float> weightValues(weights->value().numElements());
+        kernels::loadAsFloat(weights->value(), 0, weightValues.size(), weightValues.data());
+        // Dense weights are [K, M] with the channel innermost, Conv2D weights [O, C, KH, KW] with it outermost
+        auto perChannel = weightValues.size() / channels;
+        for (std::size_t i = 0; i < weightValues.size(); i++)
+            weightValues[i] *= multiplier[isDense ? i % channels : i / perChannel];
+        std::vector<float> biasValues(channels);
+        kernels::loadAsFloat(bias->value(), 0, channels, biasValues.data());
+        for (std::size_t c = 0; c < channels; c++)
+            biasValues[c] = (biasValues[c] - mean[c]) * multiplier[c] + shift[c];
+
+        // Fresh tensors: the original storage may be shared with tensors the caller still holds
+        weights->value() = fromFloat(weightValues, weights->value());
+        bias->value() = fromFloat(biasValues, bias->value());
+        replaceAllUses(batchNorm->outputs()[0], layerOutput);
+        folded++;
+    }
+    return folded;
+}
+
+} // graph
+} // yt_ml_toolkit
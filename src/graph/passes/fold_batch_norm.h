@@ -0,0 +1,16 @@
+#pragma once
+
+#include <graph/traversal.h>
+
+namespace yt {
+namespace graph {
+
+// Inference-time pass: every BatchNorm whose input comes straight from a Conv2D or Dense with
+// Constant weights and bias is folded into them (weights scaled per output channel, bias
+// shifted) and its consumers are rewired to the layer output. A BatchNorm is left alone when the
+// layer output or its weights/bias have other consumers. Run it before compiling an Executor.
+// Returns the number of folded BatchNorm nodes.
+std::size_t foldBatchNorm(const Nodes &inputs, const Nodes &outputs);
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,19 @@
+#include "rewrite.h"
+
+namespace yt {
+namespace graph {
+
+void replaceAllUses(const TensorDescriptor::Ptr &from, const TensorDescriptor::Ptr &to)
+{
+    auto consumers = from->consumers();
+    for (auto consumer : consumers)
+    {
+        auto &inputs = consumer->inputs();
+        for (std::size_t i = 0; i < inputs.size(); i++)
+            if (inputs[i].lock() == from)
+                consumer->replaceInput(i, to);
+    }
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <graph/node_base.h>
+
+namespace yt {
+namespace graph {
+
+// Points every consumer of from at to instead; from ends up without consumers
+void replaceAllUses(const TensorDescriptor::Ptr &from, const TensorDescriptor::Ptr &to);
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,65 @@
+#include "pooling.h"
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+Pool2D::Pool2D(const TensorDescriptor::WeakPtr &input, kernels::Pool2DParams params, const std::string &name) :
+    Node {std::move(std::vector<TensorDescriptor::WeakPtr>{input}), name},
+    params_ {params}
+{
+    auto inputPtr = input.lock();
+    if (!inputPtr)
+        throwException(name_ + ": input is not available");
+    const auto &inShape = inputPtr->shape();
+    if (inShape.size() != 4)
+        throwException(name_ + ": expected NCHW input");
+    Shape outShape {inShape[0], inShape[1],
+                    kernels::convOutputSize(inShape[2], params_.kernelSize, params_.stride, params_.padding),
+                    kernels::convOutputSize(inShape[3], params_.kernelSize, params_.stride, params_.padding)};
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, outShape, this)};
+}
+
+const kernels::Pool2DParams &Pool2D::params() const
+{
+    return params_;
+}
+
+Node::Kernel Pool2D::kernel(const std::vector<Shape> &) const
+{
+    return [params = params_](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::pool2d(*inputs[0], params, *outputs[0]);
+    };
+}
+
+double Pool2D::flops(const std::vector<Shape> &inputShapes) const
+{
+    const auto &in = inputShapes[0];
+    auto outputs = static_cast<double>(in[0] * in[1] *
+                                       kernels::convOutputSize(in[2], params_.kernelSize, params_.stride, params_.padding) *
+                                       kernels::convOutputSize(in[3], params_.kernelSize, params_.stride, params_.padding));
+    // One compare or add per window element
+    return outputs * params_.kernelSize * params_.kernelSize;
+}
+
+std::vector<Layout> Pool2D::supportedLayouts() const
+{
+    return {Layout::nChw8c, Layout::nhwc, Layout::nchw};
+}
+
+MaxPool2D::MaxPool2D(const TensorDescriptor::WeakPtr &input, std::size_t kernelSize, std::size_t stride,
+                     std::size_t padding, const std::string &name) :
+    Pool2D {input, {kernels::PoolingType::max, kernelSize, stride, padding},
+            name.empty() ? "max_pool_" + std::to_string(genUniqueNameSuffix()) : name}
+{
+}
+
+AvgPool2D::AvgPool2D(const TensorDescriptor::WeakPtr &input, std::size_t kernelSize, std::size_t stride,
+                     std::size_t padding, const std::string &name) :
+    Pool2D {input, {kernels::PoolingType::average, kernelSize, stride, padding},
+            name.empty() ? "avg_pool_" + std::to_string(genUniqueNameSuffix()) : name}
+{
+}
+
+} // graph
+} // yt_ml_toolkit
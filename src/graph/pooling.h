@@ -0,0 +1,38 @@
+#pragma once
+
+#include "node_base.h"
+#include <kernels/layers.h>
+
+namespace yt {
+namespace graph {
+
+// Spatial pooling of an NCHW tensor
+class Pool2D : public Node
+{
+public:
+    Pool2D(const TensorDescriptor::WeakPtr &input, kernels::Pool2DParams params, const std::string &name);
+    const kernels::Pool2DParams &params() const;
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+    std::vector<Layout> supportedLayouts() const override;
+
+private:
+    kernels::Pool2DParams params_;
+};
+
+class MaxPool2D : public Pool2D
+{
+public:
+    MaxPool2D(const TensorDescriptor::WeakPtr &input, std::size_t kernelSize, std::size_t stride,
+              std::size_t padding = 0, const std::string &name = std::string{});
+};
+
+class AvgPool2D : public Pool2D
+{
+public:
+    AvgPool2D(const TensorDescriptor::WeakPtr &input, std::size_t kernelSize, std::size_t stride,
+              std::size_t padding = 0, const std::string &name = std::string{});
+};
+
+} // graph
+} // yt_ml_toolkit
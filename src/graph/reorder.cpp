@@ -0,0 +1,40 @@
+#include "reorder.h"
+#include <kernels/reorder.h>
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+Reorder::Reorder(const TensorDescriptor::WeakPtr &input, Layout layout, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{input}),
+        name.empty() ? "reorder_" + std::to_string(genUniqueNameSuffix()) : name
+    }
+{
+    auto inputPtr = input.lock();
+    if (!inputPtr)
+        throwException(name_ + ": input is not available");
+    if (inputPtr->shape().size() != 4 || inputPtr->dataType() != fp32)
+        throwException(name_ + ": expected a 4D fp32 input");
+    outputs_ = {std::make_shared<TensorDescriptor>(fp32, inputPtr->shape(), this, layout)};
+}
+
+Layout Reorder::layout() const
+{
+    return outputs_.front()->layout();
+}
+
+Node::Kernel Reorder::kernel(const std::vector<Shape> &) const
+{
+    return [](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::reorder(*inputs[0], *outputs[0]);
+    };
+}
+
+std::vector<Layout> Reorder::supportedLayouts() const
+{
+    return {Layout::nchw, Layout::nhwc, Layout::nChw8c};
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// Converts a 4D fp32 tensor into another physical layout; the logical shape is unchanged
+class Reorder : public Node
+{
+public:
+    Reorder(const TensorDescriptor::WeakPtr &input, Layout layout, const std::string &name = std::string{});
+    Layout layout() const;
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    std::vector<Layout> supportedLayouts() const override;
+};
+
+} // graph
+} // yt_ml_toolkit
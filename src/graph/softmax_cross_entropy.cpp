@@ -0,0 +1,45 @@
+#include "softmax_cross_entropy.h"
+#include <kernels/softmax_cross_entropy.h>
+#include <throw_exception.h>
+
+namespace yt {
+namespace graph {
+
+SoftmaxCrossEntropy::SoftmaxCrossEntropy(const TensorDescriptor::WeakPtr &logits, const TensorDescriptor::WeakPtr &labels,
+                                         runtime::ThreadPool *pool, const std::string &name) :
+    Node {
+        std::move(std::vector<TensorDescriptor::WeakPtr>{logits, labels}),
+        name.empty() ? "softmax_cross_entropy_" + std::to_string(genUniqueNameSuffix()) : name
+    },
+    pool_ {pool}
+{
+    auto logitsPtr = logits.lock();
+    auto labelsPtr = labels.lock();
+    if (!logitsPtr || !labelsPtr)
+        throwException(name_ + ": inputs are not available");
+    const auto &shape = logitsPtr->shape();
+    if (shape.size() != 2 || labelsPtr->shape().size() != 1 || labelsPtr->shape()[0] != shape[0])
+        throwException(name_ + ": expected logits [N, C] and labels [N]");
+    if (logitsPtr->dataType() != fp32 && logitsPtr->dataType() != fp16)
+        throwException(name_ + ": logits must be floating point");
+    outputs_ = {
+        std::make_shared<TensorDescriptor>(fp32, Shape{shape[0]}, this),
+        std::make_shared<TensorDescriptor>(fp32, shape, this),
+    };
+}
+
+Node::Kernel SoftmaxCrossEntropy::kernel(const std::vector<Shape> &) const
+{
+    return [pool = pool_](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        kernels::softmaxCrossEntropy(*inputs[0], *inputs[1], *outputs[0], outputs[1], pool);
+    };
+}
+
+double SoftmaxCrossEntropy::flops(const std::vector<Shape> &inputShapes) const
+{
+    // Per logit: max, subtract, exp (about a dozen operations as a polynomial), sum and the gradient
+    return 16. * static_cast<double>(inputShapes[0].numElements());
+}
+
+} // graph
+} // yt_ml_toolkit
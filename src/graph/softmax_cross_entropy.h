@@ -0,0 +1,27 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace runtime {
+class ThreadPool;
+} // runtime
+
+namespace graph {
+
+// Fused log-softmax + cross-entropy over logits [N, C] and integer labels [N].
+// Output #0 is the per-sample loss [N], output #1 the gradient of that loss w.r.t. the logits [N, C].
+class SoftmaxCrossEntropy : public Node
+{
+public:
+    SoftmaxCrossEntropy(const TensorDescriptor::WeakPtr &logits, const TensorDescriptor::WeakPtr &labels,
+                        runtime::ThreadPool *pool = nullptr, const std::string &name = std::string{});
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    double flops(const std::vector<Shape> &inputShapes) const override;
+
+private:
+    runtime::ThreadPool *pool_;
+};
+
+} // graph
+} // yt_ml_toolkit
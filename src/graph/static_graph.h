@@ -0,0 +1,317 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+// Graphs described as types, for small fixed models.
+// Every node is a type whose template arguments are its inputs, so shapes are checked with static_assert and the
+// execution order is a type list computed at compile time. StaticGraph::run() then expands into straight-line code
+// over stack-resident buffers: no virtual calls, no reference counting, no allocation.
+//
+//     using X = Input<0, StaticShape<1, 784>>;
+//     using H = Relu<Dense<X, 128>>;
+//     using Y = Dense<H, 10>;
+//     StaticGraph<Y> model;
+//     model.parameters<Dense<X, 128>>().weights = ...;
+//     model.run({image}, {logits});
+//
+// Identical types denote the same node, so a subexpression used twice is evaluated once. Use the Tag argument of
+// Dense to get two distinct layers with the same input and width. Dynamic graphs keep using graph::Node.
+namespace yt {
+namespace graph {
+namespace static_graph {
+
+template<std::size_t... Dims>
+struct StaticShape
+{
+    static constexpr std::size_t rank = sizeof...(Dims);
+    static constexpr std::size_t numElements = (Dims * ... * 1);
+    static constexpr std::array<std::size_t, sizeof...(Dims)> dims {Dims...};
+};
+
+template<typename... Types>
+struct TypeList
+{
+    static constexpr std::size_t size = sizeof...(Types);
+};
+
+namespace detail {
+
+template<typename T, typename List>
+struct Contains;
+
+template<typename T, typename... Types>
+struct Contains<T, TypeList<Types...>> : std::bool_constant<(std::is_same_v<T, Types> || ...)> {};
+
+template<typename T, typename List>
+struct IndexOf;
+
+template<typename T, typename... Rest>
+struct IndexOf<T, TypeList<T, Rest...>> : std::integral_constant<std::size_t, 0> {};
+
+template<typename T, typename First, typename... Rest>
+struct IndexOf<T, TypeList<First, Rest...>> :
+    std::integral_constant<std::size_t, 1 + IndexOf<T, TypeList<Rest...>>::value> {};
+
+template<typename List, typename T>
+struct Append;
+
+template<typename... Types, typename T>
+struct Append<TypeList<Types...>, T>
+{
+    using type = TypeList<Types..., T>;
+};
+
+// Post-order depth-first walk: a node is appended after all of its arguments, and only once
+template<typename Visited, typename... Nodes>
+struct VisitAll
+{
+    using type = Visited;
+};
+
+template<typename Visited, typename Node, bool = Contains<Node, Visited>::value>
+struct Visit
+{
+    using type = Visited;
+};
+
+template<typename Visited, typename Node>
+struct VisitArgs;
+
+template<typename Visited, typename... Args>
+struct VisitArgs<Visited, TypeList<Args...>> : VisitAll<Visited, Args...> {};
+
+template<typename Visited, typename Node>
+struct Visit<Visited, Node, false>
+{
+    using type = typename Append<typename VisitArgs<Visited, typename Node::Args>::type, Node>::type;
+};
+
+template<typename Visited, typename Node, typename... Rest>
+struct VisitAll<Visited, Node, Rest...> : VisitAll<typename Visit<Visited, Node>::type, Rest...> {};
+
+template<typename Node>
+struct IsInput : std::false_type {};
+
+struct NoParameters {};
+
+template<typename Node, typename = void>
+struct ParametersOf
+{
+    using type = NoParameters;
+};
+
+template<typename Node>
+struct ParametersOf<Node, std::void_t<typename Node::Parameters>>
+{
+    using type = typename Node::Parameters;
+};
+
+// Inputs are read in place, every other node owns an aligned buffer.
+// The empty constructors keep std::tuple from zero-filling the buffers on every run.
+template<typename Node, bool = IsInput<Node>::value>
+struct Storage
+{
+    Storage() {}
+    alignas(64) std::array<float, Node::Shape::numElements> values;
+    float *data() { return values.data(); }
+    const float *data() const { return values.data(); }
+};
+
+template<typename Node>
+struct Storage<Node, true>
+{
+    Storage() {}
+    const float *values;
+    const float *data() const { return values; }
+};
+
+} // detail
+
+template<typename... Outputs>
+using TopologicalOrder = typename detail::VisitAll<TypeList<>, Outputs...>::type;
+
+template<std::size_t Index, typename ShapeT>
+struct Input
+{
+    using Shape = ShapeT;
+    using Args = TypeList<>;
+    static constexpr std::size_t index = Index;
+};
+
+namespace detail {
+
+template<std::size_t Index, typename ShapeT>
+struct IsInput<Input<Index, ShapeT>> : std::true_type {};
+
+template<typename Node>
+constexpr bool isInputWithIndex(std::size_t index)
+{
+    if constexpr (IsInput<Node>::value)
+        return Node::index == index;
+    else
+        return false;
+}
+
+// Every index below the number of inputs belongs to exactly one input, so none is unbound or shared
+template<typename... Nodes>
+constexpr bool inputIndicesArePermutation()
+{
+    constexpr std::size_t numInputs = (std::size_t {IsInput<Nodes>::value} + ... + 0);
+    for (std::size_t i = 0; i < numInputs; i++)
+        if ((std::size_t {isInputWithIndex<Nodes>(i)} + ... + 0) != 1)
+            return false;
+    return true;
+}
+
+} // detail
+
+// The Input nodes of List are numbered 0..N-1, each index used once
+template<typename List>
+struct InputsAreDense;
+
+template<typename... Nodes>
+struct InputsAreDense<TypeList<Nodes...>> : std::bool_constant<detail::inputIndicesArePermutation<Nodes...>()> {};
+
+// output[N, M] = input[N, K] * weights[K, M] + bias[M], same layout as graph::Dense
+template<typename X, std::size_t Units, typename Tag = void>
+struct Dense
+{
+    static_assert(X::Shape::rank == 2, "Dense expects a [N, K] input");
+    static constexpr std::size_t kBatch = X::Shape::dims[0];
+    static constexpr std::size_t kInputs = X::Shape::dims[1];
+
+    using Shape = StaticShape<kBatch, Units>;
+    using Args = TypeList<X>;
+    struct Parameters
+    {
+        alignas(64) std::array<float, kInputs * Units> weights {};
+        alignas(64) std::array<float, Units> bias {};
+    };
+
+    static void evaluate(const Parameters &parameters, const float *input, float *output)
+    {
+        for (std::size_t n = 0; n < kBatch; n++)
+        {
+            auto row = output + n * Units;
+            for (std::size_t m = 0; m < Units; m++)
+                row[m] = parameters.bias[m];
+            for (std::size_t k = 0; k < kInputs; k++)
+            {
+                auto a = input[n * kInputs + k];
+                auto weights = parameters.weights.data() + k * Units;
+                for (std::size_t m = 0; m < Units; m++)
+                    row[m] += a * weights[m];
+            }
+        }
+    }
+};
+
+template<typename X>
+struct Relu
+{
+    using Shape = typename X::Shape;
+    using Args = TypeList<X>;
+
+    static void evaluate(const detail::NoParameters &, const float *input, float *output)
+    {
+        for (std::size_t i = 0; i < Shape::numElements; i++)
+            output[i] = input[i] > 0.f ? input[i] : 0.f;
+    }
+};
+
+template<typename A, typename B>
+struct Add
+{
+    static_assert(std::is_same_v<typename A::Shape, typename B::Shape>, "Add expects operands of the same shape");
+    using Shape = typename A::Shape;
+    using Args = TypeList<A, B>;
+
+    static void evaluate(const detail::NoParameters &, const float *a, const float *b, float *output)
+    {
+        for (std::size_t i = 0; i < Shape::numElements; i++)
+            output[i] = a[i] + b[i];
+    }
+};
+
+template<typename... Outputs>
+class StaticGraph
+{
+    template<typename List>
+    struct Layout;
+
+    template<typename... Nodes>
+    struct Layout<TypeList<Nodes...>>
+    {
+        using Parameters = std::tuple<typename detail::ParametersOf<Nodes>::type...>;
+        using Buffers = std::tuple<detail::Storage<Nodes>...>;
+        static constexpr std::size_t numInputs = (std::size_t {detail::IsInput<Nodes>::value} + ...);
+    };
+
+public:
+    using Order = TopologicalOrder<Outputs...>;
+    static constexpr std::size_t kNumInputs = Layout<Order>::numInputs;
+    static constexpr std::size_t kNumOutputs = sizeof...(Outputs);
+    static_assert(InputsAreDense<Order>::value, "Input indices must be 0..N-1, each used once");
+
+    template<typename Node>
+    typename Node::Parameters &parameters()
+    {
+        return std::get<detail::IndexOf<Node, Order>::value>(parameters_);
+    }
+
+    template<typename Node>
+    const typename Node::Parameters &parameters() const
+    {
+        return std::get<detail::IndexOf<Node, Order>::value>(parameters_);
+    }
+
+    // inputs[i] feeds Input<i, ...>, outputs[j] receives Outputs...[j]
+    void run(const std::array<const float*, kNumInputs> &inputs, const std::array<float*, kNumOutputs> &outputs) const
+    {
+        typename Layout<Order>::Buffers buffers;
+        evaluateAll(buffers, inputs, Order{});
+        copyOutputs(buffers, outputs, std::index_sequence_for<Outputs...>{});
+    }
+
+private:
+    template<typename Buffers, typename... Nodes>
+    void evaluateAll(Buffers &buffers, const std::array<const float*, kNumInputs> &inputs, TypeList<Nodes...>) const
+    {
+        (evaluateNode<Nodes>(buffers, inputs, typename Nodes::Args{}), ...);
+    }
+
+    template<typename Node, typename Buffers, typename... Args>
+    void evaluateNode(Buffers &buffers, const std::array<const float*, kNumInputs> &inputs, TypeList<Args...>) const
+    {
+        auto &storage = std::get<detail::IndexOf<Node, Order>::value>(buffers);
+        if constexpr (detail::IsInput<Node>::value)
+            storage.values = inputs[Node::index];
+        else
+            Node::evaluate(std::get<detail::IndexOf<Node, Order>::value>(parameters_),
+                           std::get<detail::IndexOf<Args, Order>::value>(buffers).data()..., storage.data());
+    }
+
+    template<typename Buffers, std::size_t... Indices>
+    static void copyOutputs(const Buffers &buffers, const std::array<float*, kNumOutputs> &outputs,
+                            std::index_sequence<Indices...>)
+    {
+        (copyOutput<Outputs>(buffers, outputs[Indices]), ...);
+    }
+
+    template<typename Node, typename Buffers>
+    static void copyOutput(const Buffers &buffers, float *output)
+    {
+        auto source = std::get<detail::IndexOf<Node, Order>::value>(buffers).data();
+        for (std::size_t i = 0; i < Node::Shape::numElements; i++)
+            output[i] = source[i];
+    }
+
+    typename Layout<Order>::Parameters parameters_ {};
+};
+
+} // static_graph
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,143 @@
+#include "topological_order.h"
+#include "node_base.h"
+#include <throw_exception.h>
+#include <algorithm>
+
+namespace yt {
+namespace graph {
+
+namespace {
+
+template<typename Callback>
+void forEachConsumer(Node &node, Callback callback)
+{
+    for (auto &output : node.outputs())
+        for (auto consumer : output->consumers())
+            callback(consumer);
+}
+
+template<typename Callback>
+void forEachProducer(Node &node, Callback callback)
+{
+    for (auto &input : node.inputs())
+        if (auto descriptor = input.lock())
+            if (descriptor->producer())
+                callback(descriptor->producer());
+}
+
+} // namespace
+
+TopologicalOrder &TopologicalOrder::instance()
+{
+    static TopologicalOrder order;
+    return order;
+}
+
+std::mutex &TopologicalOrder::mutex()
+{
+    return mutex_;
+}
+
+void TopologicalOrder::insert(Node *node)
+{
+    if (freeIds_.empty())
+        node->id_ = nextId_++;
+    else
+    {
+        node->id_ = freeIds_.top();
+        freeIds_.pop();
+    }
+    // A new node has no consumers yet, so the end of the order is always valid for it
+    node->topologicalIndex_ = nodes_.size();
+    nodes_.push_back(node);
+}
+
+void TopologicalOrder::erase(Node *node)
+{
+    nodes_[node->topologicalIndex_] = nullptr;
+    freeIds_.push(node->id_);
+    numHoles_++;
+    if (numHoles_ > 64 && numHoles_ * 2 > nodes_.size())
+        compact();
+}
+
+void TopologicalOrder::addEdge(Node *from, Node *to)
+{
+    auto lowerBound = to->topologicalIndex_;
+    auto upperBound = from->topologicalIndex_;
+    if (from == to)
+        throwException("Edge " + from->name() + " -> " + to->name() + " creates a cycle");
+    if (upperBound < lowerBound)
+        return;
+
+    std::vector<Node*> forward;
+    visited_.clear();
+    visited_.insert(*to);
+    std::vector<Node*> stack {to};
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+        forward.push_back(current);
+        forEachConsumer(*current, [&](Node *consumer) {
+            if (consumer == from)
+                throwException("Edge " + from->name() + " -> " + to->name() + " creates a cycle");
+            if (consumer->topologicalIndex_ < upperBound && visited_.insert(*consumer))
+                stack.push_back(consumer);
+        });
+    }
+
+    std::vector<Node*> backward;
+    stack = {from};
+    visited_.insert(*from);
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+        backward.push_back(current);
+        forEachProducer(*current, [&](Node *producer) {
+            if (producer->topologicalIndex_ > lowerBound && visited_.insert(*producer))
+                stack.push_back(producer);
+        });
+    }
+
+    auto byIndex = [](const Node *a, const Node *b) { return a->topologicalIndex_ < b->topologicalIndex_; };
+    std::sort(forward.begin(), forward.end(), byIndex);
+    std::sort(backward.begin(), backward.end(), byIndex);
+    std::vector<std::size_t> slots;
+    slots.reserve(forward.size() + backward.size());
+    for (auto node : backward)
+        slots.push_back(node->topologicalIndex_);
+    for (auto node : forward)
+        slots.push_back(node->topologicalIndex_);
+    std::sort(slots.begin(), slots.end());
+    // Ancestors of from take the lowest of the affected slots, descendants of to the rest
+    auto slot = slots.begin();
+    for (auto nodes : {&backward, &forward})
+        for (auto node : *nodes)
+        {
+            node->topologicalIndex_ = *slot++;
+            nodes_[node->topologicalIndex_] = node;
+        }
+}
+
+std::size_t TopologicalOrder::index(const Node *node) const
+{
+    return node->topologicalIndex_;
+}
+
+Node *TopologicalOrder::at(std::size_t index) const
+{
+    return nodes_[index];
+}
+
+void TopologicalOrder::compact()
+{
+    nodes_.erase(std::remove(nodes_.begin(), nodes_.end(), nullptr), nodes_.end());
+    for (std::size_t i = 0; i < nodes_.size(); i++)
+        nodes_[i]->topologicalIndex_ = i;
+    numHoles_ = 0;
+}
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "visited_set.h"
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace yt {
+namespace graph {
+
+// Registry of live nodes: hands out dense node ids and keeps a topological index of every node
+// valid across node creation/destruction and edge insertion with the Pearce-Kelly dynamic
+// topological sort: adding an edge x -> y only reorders nodes whose index lies between
+// index(y) and index(x).
+// Callers must hold mutex() around any call and around the graph edit it describes.
+class TopologicalOrder
+{
+public:
+    static TopologicalOrder &instance();
+
+    std::mutex &mutex();
+    void insert(Node *node);
+    void erase(Node *node);
+    // Reorders nodes so that from precedes to; throws yt::Exception if the edge closes a cycle
+    void addEdge(Node *from, Node *to);
+    std::size_t index(const Node *node) const;
+    // Node at a topological index; nullptr for the slot of a destroyed node
+    Node *at(std::size_t index) const;
+
+private:
+    TopologicalOrder() = default;
+    void compact();
+
+    std::mutex mutex_ {};
+    std::vector<Node*> nodes_ {};
+    std::size_t numHoles_ {};
+    std::size_t nextId_ {};
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> freeIds_ {};
+    VisitedSet visited_ {};
+};
+
+} // graph
+} // yt_ml_toolkit
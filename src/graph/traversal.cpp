@@ -1,9 +1,11 @@
 #include <throw_exception.h>
 #include <graph/output.h>
 #include "traversal.h"
+#include "topological_order.h"
+#include "visited_set.h"
 #include <algorithm>
 #include <list>
-#include <set>
+#include <mutex>
 #include <string>
 
 namespace yt {
@@ -11,6 +13,63 @@ namespace graph {
 
 using namespace std::string_literals;
 
+namespace {
+
+// Traversals only use their visited set before invoking user callbacks, so one set per thread
+// can be reused without clearing its storage
+VisitedSet &threadVisitedSet()
+{
+    thread_local VisitedSet visited;
+    visited.clear();
+    return visited;
+}
+
+// The topological walk gives up on a span this many slots larger than the nodes it has marked
+constexpr std::size_t kMinScanBudget = 256;
+constexpr std::size_t kScannedPerMarkedNode = 4;
+
+Node *producerOf(const Node &node, std::size_t i)
+{
+    auto input = node.inputs()[i].lock();
+    if (!input)
+        throwException("Topological order failure: Input #"s + std::to_string(i) + " of "s + node.name() +
+                       " is not available"s);
+    return input->producer();
+}
+
+// Every node the outputs depend on, sorted by topological index; the caller holds the order mutex
+Nodes sortedDependencies(const Nodes &outputs, const TopologicalOrder &order, VisitedSet &visited)
+{
+    visited.clear();
+    std::vector<Node*> stack;
+    std::vector<Node*> found;
+    for (auto &output : outputs)
+        if (visited.insert(*output))
+            stack.push_back(output.get());
+    while (!stack.empty())
+    {
+        auto node = stack.back();
+        stack.pop_back();
+        found.push_back(node);
+        for (std::size_t i = 0; i < node->inputs().size(); i++)
+        {
+            auto producer = producerOf(*node, i);
+            if (visited.insert(*producer))
+                stack.push_back(producer);
+        }
+    }
+    std::sort(found.begin(), found.end(), [&order](const Node *a, const Node *b) {
+        return order.index(a) < order.index(b);
+    });
+    Nodes result;
+    result.reserve(found.size());
+    for (auto node : found)
+        result.push_back(node->shared_from_this());
+    return result;
+}
+
+} // namespace
+
 void backBFSTraversal(Node& node, std::function<bool(Node&)> callback)
 {
     std::list<Node*> list {&node};
@@ -82,18 +141,39 @@ void backDFSTraversal(Node &node, std::function<bool (Node &)> callback)
 
 Nodes traverseInExecutionOrder(const Nodes &inputs, const Nodes &outputs, std::function<void(Node::Ptr)> callback)
 {
-    Nodes reverseOutputs {outputs.rbegin(), outputs.rend()};
+    // Iterative post-order DFS over producers: a node is emitted once all of its producers are, and
+    // visited marks prune shared subgraphs, so every node and edge is handled once
+    auto &visited = threadVisitedSet();
     Nodes orderedNodes {};
-    for (auto& output : reverseOutputs)
-        backDFSTraversal(*output, [&orderedNodes](Node& node) { orderedNodes.push_back(node.shared_from_this()); return true; });
-    std::reverse(orderedNodes.begin(), orderedNodes.end());
-    auto last = orderedNodes.end();
-    for (auto it = orderedNodes.begin(); it != last; it++)
-        last = std::remove(it + 1, last, *it);
-    orderedNodes.erase(last, orderedNodes.end());
-    std::set<Node::Ptr> nodesSet {orderedNodes.begin(), orderedNodes.end()};
+    std::vector<std::pair<Node*, std::size_t>> stack;
+    for (auto &output : outputs)
+    {
+        if (!visited.insert(*output))
+            continue;
+        stack.emplace_back(output.get(), output->inputs().size());
+        while (!stack.empty())
+        {
+            auto &top = stack.back();
+            auto node = top.first;
+            if (top.second == 0)
+            {
+                orderedNodes.push_back(node->shared_from_this());
+                stack.pop_back();
+                continue;
+            }
+            // Inputs are entered last to first, which emits the subgraph of input #0 right before its consumer
+            auto i = --top.second;
+            auto input = node->inputs()[i].lock();
+            if (!input)
+                throwException("Execution order failure: Input #"s + std::to_string(i) + " of "s + node->name() +
+                               " is not available"s);
+            auto producer = input->producer();
+            if (visited.insert(*producer))
+                stack.emplace_back(producer, producer->inputs().size());
+        }
+    }
     for (auto& input : inputs)
-        if (nodesSet.find(input) == nodesSet.end())
+        if (!visited.contains(*input))
             throwException("Input "s + input->name() + " is not part of the graph"s);
     if (callback)
         for (auto& node : orderedNodes)
@@ -101,6 +181,67 @@ Nodes traverseInExecutionOrder(const Nodes &inputs, const Nodes &outputs, std::f
     return orderedNodes;
 }
 
+Nodes traverseInTopologicalOrder(const Nodes &inputs, const Nodes &outputs, std::function<void(Node::Ptr)> callback)
+{
+    // The maintained order is process-wide, so other live graphs interleave with this one. Walking it
+    // downwards from the last output, marking the producers of every marked node, reads the outputs'
+    // dependencies off in order without a search or sort, but costs the slots scanned between the last
+    // output and the lowest dependency rather than the size of this graph. Once the scan outgrows the
+    // marked nodes the dependencies are collected by a DFS and sorted by index instead; both give the
+    // same order.
+    auto &visited = threadVisitedSet();
+    Nodes orderedNodes {};
+    {
+        auto &order = TopologicalOrder::instance();
+        // Indices are read under the same lock as the walk, so no edge insertion can move them in between
+        std::lock_guard<std::mutex> lock {order.mutex()};
+        std::size_t pending {};
+        std::size_t last {};
+        for (auto &output : outputs)
+            if (visited.insert(*output))
+            {
+                pending++;
+                last = std::max(last, order.index(output.get()) + 1);
+            }
+        auto marked = pending;
+        std::size_t scanned {};
+        bool sparse {false};
+        for (auto index = last; pending > 0 && index-- > 0;)
+        {
+            if (++scanned > kMinScanBudget + kScannedPerMarkedNode * marked)
+            {
+                sparse = true;
+                break;
+            }
+            auto node = order.at(index);
+            if (!node || !visited.contains(*node))
+                continue;
+            pending--;
+            orderedNodes.push_back(node->shared_from_this());
+            for (std::size_t i = 0; i < node->inputs().size(); i++)
+                if (visited.insert(*producerOf(*node, i)))
+                {
+                    pending++;
+                    marked++;
+                }
+        }
+        if (sparse)
+            orderedNodes = sortedDependencies(outputs, order, visited);
+        else
+        {
+            if (pending != 0)
+                throwException("Topological order failure: producers are missing below their consumers"s);
+            std::reverse(orderedNodes.begin(), orderedNodes.end());
+        }
+    }
+    for (auto& input : inputs)
+        if (!visited.contains(*input))
+            throwException("Input "s + input->name() + " is not part of the graph"s);
+    if (callback)
+        for (auto& node : orderedNodes)
+            callback(node);
+    return orderedNodes;
+}
 
 } // namespace yt
 } // namespace graph
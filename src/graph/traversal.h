@@ -10,6 +10,10 @@ namespace graph {
 using Nodes = std::vector<Node::Ptr>;
 
 Nodes traverseInExecutionOrder(const Nodes &inputs, const Nodes &outputs, std::function<void(Node::Ptr)> callback = nullptr);
+// Same node set as traverseInExecutionOrder, ordered by the incrementally maintained Node::topologicalIndex();
+// this is the order the plan compiler and graph passes use. Read off the order without a search or sort
+// while the graph's nodes fill most of their index span, by a DFS and a sort once other graphs' nodes dominate it.
+Nodes traverseInTopologicalOrder(const Nodes &inputs, const Nodes &outputs, std::function<void(Node::Ptr)> callback = nullptr);
 void BFSTraversal(Node& node, std::function<bool(Node&)> callback);
 void backBFSTraversal(Node& node, std::function<bool(Node&)> callback);
 void DFSTraversal(Node& node, std::function<bool(Node&)> callback);
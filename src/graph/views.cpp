@@ -0,0 +1,199 @@
+#include "views.h"
+#include <kernels/strided.h>
+#include <throw_exception.h>
+#include <algorithm>
+
+namespace yt {
+namespace graph {
+
+namespace {
+
+// Strides of the same elements under another shape, if every group of old dimensions merged or split
+// by the reshape is itself laid out contiguously
+std::optional<Strides> reshapeStrides(const Shape &from, const Strides &strides, const Shape &to)
+{
+    if (from.numElements() == 0)
+        return contiguousStrides(to);
+    Shape oldShape;
+    Strides oldStrides;
+    for (std::size_t d = 0; d < from.size(); d++)
+        if (from[d] != 1)
+        {
+            oldShape.push_back(from[d]);
+            oldStrides.push_back(strides[d]);
+        }
+    Strides result(to.size(), 1);
+    std::size_t oldBegin {}, newBegin {};
+    while (newBegin < to.size())
+    {
+        if (to[newBegin] == 1)
+        {
+            newBegin++;
+            continue;
+        }
+        // Smallest groups of old and new dimensions with equal element counts
+        auto newEnd = newBegin + 1, oldEnd = oldBegin + 1;
+        auto newCount = to[newBegin], oldCount = oldShape[oldBegin];
+        while (newCount != oldCount)
+            if (newCount < oldCount)
+                newCount *= to[newEnd++];
+            else
+                oldCount *= oldShape[oldEnd++];
+        for (auto d = oldBegin; d + 1 < oldEnd; d++)
+            if (oldStrides[d] != oldStrides[d + 1] * static_cast<std::ptrdiff_t>(oldShape[d + 1]))
+                return std::nullopt;
+        result[newEnd - 1] = oldStrides[oldEnd - 1];
+        for (auto d = newEnd - 1; d > newBegin; d--)
+            result[d - 1] = result[d] * static_cast<std::ptrdiff_t>(to[d]);
+        newBegin = newEnd;
+        oldBegin = oldEnd;
+    }
+    return result;
+}
+
+Shape resolveReshape(const std::string &name, const Shape &target, std::size_t numElements)
+{
+    Shape shape = target;
+    auto dynamic = std::find(shape.begin(), shape.end(), kDynamicDim);
+    if (dynamic != shape.end())
+    {
+        *dynamic = 1;
+        auto known = shape.numElements();
+        if (known == 0 || numElements % known)
+            throwException(name + ": cannot infer the dynamic dimension");
+        *dynamic = numElements / known;
+    }
+    if (shape.numElements() != numElements)
+        throwException(name + ": element count doesn't match the input");
+    return shape;
+}
+
+} // namespace
+
+View::View(const TensorDescriptor::WeakPtr &input, const std::string &name) :
+    Node {std::move(std::vector<TensorDescriptor::WeakPtr>{input}), name}
+{
+}
+
+TensorDescriptor::Ptr View::viewedInput() const
+{
+    auto input = inputs_.front().lock();
+    if (!input)
+        throwException(name_ + ": input is not available");
+    return input;
+}
+
+void View::setOutputShape(Shape shape)
+{
+    outputs_ = {std::make_shared<TensorDescriptor>(viewedInput()->dataType(), std::move(shape), this)};
+    outputs_.front()->setView(true);
+}
+
+Node::Kernel View::kernel(const std::vector<Shape> &) const
+{
+    // Only reached when the plan could not alias the input; the plan holds this node while it runs
+    return [this](const std::vector<const Tensor*> &inputs, const std::vector<Tensor*> &outputs) {
+        const auto &input = *inputs[0];
+        auto view = outputView({input.shape(), input.strides(), 0});
+        if (view)
+            kernels::copyStrided(input.view(view->shape, view->strides, view->offset), *outputs[0]);
+        else
+            kernels::copyStrided(input, *outputs[0]);
+    };
+}
+
+bool View::acceptsStridedInputs() const
+{
+    return true;
+}
+
+Reshape::Reshape(const TensorDescriptor::WeakPtr &input, Shape shape, const std::string &name) :
+    View {input, name.empty() ? "reshape_" + std::to_string(genUniqueNameSuffix()) : name},
+    shape_ {std::move(shape)}
+{
+    if (std::count(shape_.begin(), shape_.end(), kDynamicDim) > 1)
+        throwException(name_ + ": at most one dimension can be inferred");
+    const auto &inShape = viewedInput()->shape();
+    setOutputShape(inShape.isDynamic() ? shape_ : resolveReshape(name_, shape_, inShape.numElements()));
+}
+
+std::vector<Shape> Reshape::inferOutputShapes(const std::vector<Shape> &inputShapes) const
+{
+    return {resolveReshape(name_, shape_, inputShapes[0].numElements())};
+}
+
+std::optional<ViewGeometry> Reshape::outputView(const ViewGeometry &input) const
+{
+    auto shape = resolveReshape(name_, shape_, input.shape.numElements());
+    auto strides = reshapeStrides(input.shape, input.strides, shape);
+    if (!strides)
+        return std::nullopt;
+    return ViewGeometry {std::move(shape), std::move(*strides), input.offset};
+}
+
+Transpose::Transpose(const TensorDescriptor::WeakPtr &input, std::vector<std::size_t> permutation,
+                     const std::string &name) :
+    View {input, name.empty() ? "transpose_" + std::to_string(genUniqueNameSuffix()) : name},
+    permutation_ {std::move(permutation)}
+{
+    const auto &inShape = viewedInput()->shape();
+    auto sorted = permutation_;
+    std::sort(sorted.begin(), sorted.end());
+    bool isPermutation = sorted.size() == inShape.size();
+    for (std::size_t i = 0; isPermutation && i < sorted.size(); i++)
+        isPermutation = sorted[i] == i;
+    if (!isPermutation)
+        throwException(name_ + ": expected a permutation of the input dimensions");
+    Shape shape;
+    for (auto dim : permutation_)
+        shape.push_back(inShape[dim]);
+    setOutputShape(std::move(shape));
+}
+
+const std::vector<std::size_t> &Transpose::permutation() const
+{
+    return permutation_;
+}
+
+std::optional<ViewGeometry> Transpose::outputView(const ViewGeometry &input) const
+{
+    ViewGeometry output {{}, {}, input.offset};
+    for (auto dim : permutation_)
+    {
+        output.shape.push_back(input.shape[dim]);
+        output.strides.push_back(input.strides[dim]);
+    }
+    return output;
+}
+
+Slice::Slice(const TensorDescriptor::WeakPtr &input, std::size_t begin, std::size_t end, const std::string &name) :
+    View {input, name.empty() ? "slice_" + std::to_string(genUniqueNameSuffix()) : name},
+    begin_ {begin},
+    end_ {end}
+{
+    auto shape = viewedInput()->shape();
+    if (shape.empty() || begin_ > end_ || (shape.front() != kDynamicDim && end_ > shape.front()))
+        throwException(name_ + ": slice is out of the batch range");
+    shape.front() = end_ - begin_;
+    setOutputShape(std::move(shape));
+}
+
+std::vector<Shape> Slice::inferOutputShapes(const std::vector<Shape> &inputShapes) const
+{
+    auto shape = inputShapes[0];
+    if (end_ > shape.front())
+        throwException(name_ + ": slice end " + std::to_string(end_) + " exceeds the batch size " +
+                       std::to_string(shape.front()));
+    shape.front() = end_ - begin_;
+    return {shape};
+}
+
+std::optional<ViewGeometry> Slice::outputView(const ViewGeometry &input) const
+{
+    auto shape = inferOutputShapes({input.shape}).front();
+    return ViewGeometry {std::move(shape), input.strides,
+                         input.offset + static_cast<std::ptrdiff_t>(begin_) * input.strides.front()};
+}
+
+} // graph
+} // yt_ml_toolkit
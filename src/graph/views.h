@@ -0,0 +1,65 @@
+#pragma once
+
+#include "node_base.h"
+
+namespace yt {
+namespace graph {
+
+// Base of nodes whose output is a zero-copy view of input #0. The execution plan aliases the input's
+// storage whenever outputView() can express the result over the input's strides; only otherwise does
+// the node run its kernel, which copies the elements into a contiguous output.
+class View : public Node
+{
+public:
+    Kernel kernel(const std::vector<Shape> &inputShapes) const override;
+    bool acceptsStridedInputs() const override;
+
+protected:
+    View(const TensorDescriptor::WeakPtr &input, const std::string &name);
+    // Input descriptor, checked to be available and nchw-shaped for views
+    TensorDescriptor::Ptr viewedInput() const;
+    void setOutputShape(Shape shape);
+};
+
+// Same elements in row-major order under another shape. At most one dimension may be kDynamicDim; it
+// is inferred from the element count. Copies only when the input strides cannot be regrouped.
+class Reshape : public View
+{
+public:
+    Reshape(const TensorDescriptor::WeakPtr &input, Shape shape, const std::string &name = std::string{});
+    std::vector<Shape> inferOutputShapes(const std::vector<Shape> &inputShapes) const override;
+    std::optional<ViewGeometry> outputView(const ViewGeometry &input) const override;
+
+private:
+    Shape shape_;
+};
+
+// output dimension i is input dimension permutation[i]
+class Transpose : public View
+{
+public:
+    Transpose(const TensorDescriptor::WeakPtr &input, std::vector<std::size_t> permutation,
+              const std::string &name = std::string{});
+    const std::vector<std::size_t> &permutation() const;
+    std::optional<ViewGeometry> outputView(const ViewGeometry &input) const override;
+
+private:
+    std::vector<std::size_t> permutation_;
+};
+
+// Samples [begin, end) of the batch (first) dimension
+class Slice : public View
+{
+public:
+    Slice(const TensorDescriptor::WeakPtr &input, std::size_t begin, std::size_t end,
+          const std::string &name = std::string{});
+    std::vector<Shape> inferOutputShapes(const std::vector<Shape> &inputShapes) const override;
+    std::optional<ViewGeometry> outputView(const ViewGeometry &input) const override;
+
+private:
+    std::size_t begin_;
+    std::size_t end_;
+};
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "node_base.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace yt {
+namespace graph {
+
+// Visited marks indexed by Node::id(). clear() starts a new epoch instead of touching the marks,
+// so a set reused across traversals costs nothing to reset.
+class VisitedSet
+{
+public:
+    void clear()
+    {
+        if (++epoch_ == 0)
+        {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    // Returns false if the node was already marked in this epoch
+    bool insert(const Node &node)
+    {
+        auto id = node.id();
+        if (id >= stamps_.size())
+            stamps_.resize(std::max<std::size_t>(id + 1, stamps_.size() * 2), 0);
+        if (stamps_[id] == epoch_)
+            return false;
+        stamps_[id] = epoch_;
+        return true;
+    }
+
+    bool contains(const Node &node) const
+    {
+        auto id = node.id();
+        return id < stamps_.size() && stamps_[id] == epoch_;
+    }
+
+private:
+    std::vector<std::uint32_t> stamps_ {};
+    std::uint32_t epoch_ {1};
+};
+
+} // graph
+} // yt_ml_toolkit
@@ -0,0 +1,206 @@
+#include "autotuner.h"
+#include <throw_exception.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+constexpr int kTimedRuns = 3;
+
+double bestSeconds(const Autotuner::Benchmark &run, std::size_t candidate)
+{
+    run(candidate);  // warm caches and page in scratch buffers
+    auto best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < kTimedRuns; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run(candidate);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+std::string readCpuModel()
+{
+    std::ifstream cpuinfo {"/proc/cpuinfo"};
+    std::string line;
+    while (std::getline(cpuinfo, line))
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            auto value = line.find(':');
+            if (value == std::string::npos)
+                break;
+            value = line.find_first_not_of(" \t", value + 1);
+            auto model = value == std::string::npos ? std::string {} : line.substr(value);
+            // Tabs separate the fields of the cache file
+            std::replace(model.begin(), model.end(), '\t', ' ');
+            if (!model.empty())
+                return model;
+        }
+    return "unknown";
+}
+
+} // namespace
+
+Autotuner &Autotuner::instance()
+{
+    static Autotuner tuner {[]() {
+        auto path = std::getenv("YT_TUNING_CACHE");
+        return std::string {path ? path : ""};
+    }()};
+    return tuner;
+}
+
+Autotuner::Autotuner(std::string cachePath)
+    : cachePath_ {std::move(cachePath)}
+{
+    if (!cachePath_.empty())
+        load(cachePath_);
+}
+
+std::string Autotuner::encode(const std::string &cpu, const TuningKey &key)
+{
+    auto entry = cpu + '\t' + key.kernel + '\t' + std::to_string(static_cast<int>(key.dtype)) + '\t';
+    for (std::size_t i = 0; i < key.shape.size(); i++)
+        entry += (i ? "x" : "") + std::to_string(key.shape[i]);
+    return entry;
+}
+
+std::size_t Autotuner::select(const TuningKey &key, const std::vector<std::string> &candidates, const Benchmark &run)
+{
+    if (candidates.empty())
+        throwException("Autotuner: no candidates for " + key.kernel);
+    auto entry = encode(cpuModel(), key);
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        auto cached = entries_.find(entry);
+        if (cached != entries_.end())
+        {
+            auto found = std::find(candidates.begin(), candidates.end(), cached->second);
+            if (found != candidates.end())
+                return found - candidates.begin();
+        }
+        if (!enabled_ || candidates.size() == 1)
+            return 0;
+    }
+
+    // Benchmark without holding the lock: candidates may run tuned kernels themselves, and two threads
+    // racing on the same new key only cost a duplicate measurement
+    std::size_t winner {};
+    auto best = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        auto seconds = bestSeconds(run, i);
+        if (seconds < best)
+        {
+            best = seconds;
+            winner = i;
+        }
+    }
+    std::lock_guard<std::mutex> lock {mutex_};
+    entries_[entry] = candidates[winner];
+    tuned_++;
+    append(entry, candidates[winner]);
+    return winner;
+}
+
+std::optional<std::string> Autotuner::lookup(const TuningKey &key) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto cached = entries_.find(encode(cpuModel(), key));
+    if (cached == entries_.end())
+        return std::nullopt;
+    return cached->second;
+}
+
+void Autotuner::setEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    enabled_ = enabled;
+}
+
+bool Autotuner::enabled() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return enabled_;
+}
+
+bool Autotuner::load(const std::string &path)
+{
+    std::ifstream file {path};
+    if (!file)
+        return false;
+    Entries loaded;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto separator = line.rfind('\t');
+        // Skips torn lines left by a process killed mid-append
+        if (separator == std::string::npos || separator + 1 == line.size() ||
+            std::count(line.begin(), line.end(), '\t') != 4)
+            continue;
+        loaded[line.substr(0, separator)] = line.substr(separator + 1);
+    }
+    std::lock_guard<std::mutex> lock {mutex_};
+    for (auto &entry : loaded)
+        entries_[entry.first] = std::move(entry.second);
+    return true;
+}
+
+void Autotuner::save(const std::string &path) const
+{
+    std::ofstream file {path, std::ios::trunc};
+    std::lock_guard<std::mutex> lock {mutex_};
+    for (const auto &entry : entries_)
+        file << entry.first << '\t' << entry.second << '\n';
+    if (!file)
+        throwException("Autotuner: cannot write " + path);
+}
+
+void Autotuner::append(const std::string &entry, const std::string &winner)
+{
+    if (cachePath_.empty())
+        return;
+    // One short line per write; concurrent workers appending to the same file at worst lose a line,
+    // which is tuned again on the next start
+    std::ofstream file {cachePath_, std::ios::app};
+    file << entry << '\t' << winner << '\n';
+}
+
+void Autotuner::clear()
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    entries_.clear();
+    tuned_ = 0;
+}
+
+std::size_t Autotuner::size() const
+{
+    auto prefix = cpuModel() + '\t';
+    std::lock_guard<std::mutex> lock {mutex_};
+    return std::count_if(entries_.begin(), entries_.end(), [&prefix](const auto &entry) {
+        return entry.first.compare(0, prefix.size(), prefix) == 0;
+    });
+}
+
+std::size_t Autotuner::tuned() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return tuned_;
+}
+
+const std::string &Autotuner::cpuModel()
+{
+    static const std::string model = readCpuModel();
+    return model;
+}
+
+} // kernels
+} // yt
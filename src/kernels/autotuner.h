@@ -0,0 +1,75 @@
+#pragma once
+
+#include <shape.h>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace yt {
+namespace kernels {
+
+struct TuningKey
+{
+    std::string kernel {};
+    std::vector<std::size_t> shape {};
+    DataType dtype {fp32};
+};
+
+// Picks the fastest of a kernel's variants per (kernel, shape, dtype, CPU model).
+// The first time a key is seen every candidate is benchmarked; the winner is remembered by name and,
+// when a cache file is set, appended to it, so later processes on the same CPU model load the choice
+// at startup and never benchmark. Entries recorded on other CPU models are kept but not used.
+class Autotuner
+{
+public:
+    // Runs candidate i once on scratch outputs
+    using Benchmark = std::function<void(std::size_t candidate)>;
+
+    // Process-wide tuner backed by the file named in the YT_TUNING_CACHE environment variable, if any
+    static Autotuner &instance();
+
+    Autotuner() = default;
+    // Loads cachePath if it exists and appends every new result to it
+    explicit Autotuner(std::string cachePath);
+
+    // Returns the index of the winning candidate. Candidates are identified by name in the cache, so
+    // reordering or extending the list keeps old results valid; a cached name no longer in the list
+    // is tuned again. When tuning is disabled, unknown keys get candidate 0 without benchmarking.
+    std::size_t select(const TuningKey &key, const std::vector<std::string> &candidates, const Benchmark &run);
+    std::optional<std::string> lookup(const TuningKey &key) const;
+
+    void setEnabled(bool enabled);
+    bool enabled() const;
+
+    // Merges the entries of a cache file, later lines win; returns false if it cannot be opened
+    bool load(const std::string &path);
+    // Writes all entries, including those of other CPU models
+    void save(const std::string &path) const;
+    void clear();
+    // Entries for this CPU model
+    std::size_t size() const;
+    // Number of keys benchmarked by this tuner
+    std::size_t tuned() const;
+
+    // "model name" from /proc/cpuinfo where available
+    static const std::string &cpuModel();
+
+private:
+    using Entries = std::map<std::string, std::string>;
+
+    static std::string encode(const std::string &cpu, const TuningKey &key);
+    void append(const std::string &entry, const std::string &winner);
+
+    std::string cachePath_ {};
+    Entries entries_ {};
+    bool enabled_ {true};
+    std::size_t tuned_ {};
+    mutable std::mutex mutex_ {};
+};
+
+} // kernels
+} // yt
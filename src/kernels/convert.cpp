@@ -0,0 +1,173 @@
+#include "convert.h"
+#include "fp16.h"
+#include <throw_exception.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+template<typename T> struct TypeTag { using type = T; };
+// fp16 is stored as a uint16 bit pattern, so it needs a tag of its own to stay apart from uint16
+struct HalfTag { using type = half; };
+
+template<typename Tag>
+constexpr bool isHalf = std::is_same_v<Tag, HalfTag>;
+
+template<typename F>
+void visitDataType(DataType dtype, F &&f)
+{
+    switch (dtype)
+    {
+    case fp16: return f(HalfTag{});
+    case fp32: return f(TypeTag<float>{});
+    case int8: return f(TypeTag<std::int8_t>{});
+    case int16: return f(TypeTag<std::int16_t>{});
+    case int32: return f(TypeTag<std::int32_t>{});
+    case int64: return f(TypeTag<std::int64_t>{});
+    case uint8: return f(TypeTag<std::uint8_t>{});
+    case uint16: return f(TypeTag<std::uint16_t>{});
+    case uint32: return f(TypeTag<std::uint32_t>{});
+    case uint64: return f(TypeTag<std::uint64_t>{});
+    }
+    throwException("Unsupported data type " + std::to_string(static_cast<int>(dtype)));
+}
+
+void checkRange(const Tensor &tensor, std::size_t offset, std::size_t count)
+{
+    if (tensor.empty())
+        throwException("Tensor access failure: tensor has no storage");
+    if (offset + count > tensor.numElements())
+        throwException("Tensor access failure: range exceeds number of elements");
+    if (!tensor.isContiguous())
+        throwException("Tensor access failure: strided views must be made contiguous first");
+}
+
+// Casting a float to an integer is undefined for NaN and out-of-range values; those map to 0 and to
+// the nearest limit of D. Integer narrowing clamps as well, so every conversion saturates alike.
+template<typename D, typename S>
+D saturateCast(S value)
+{
+    using Limits = std::numeric_limits<D>;
+    if constexpr (std::is_floating_point_v<D>)
+        return static_cast<D>(value);
+    else if constexpr (std::is_floating_point_v<S>)
+    {
+        if (std::isnan(value))
+            return D {};
+        // The limits are powers of two or exact as S, so the comparisons leave only representable values
+        if (value <= static_cast<S>(Limits::lowest()))
+            return Limits::lowest();
+        if (value >= static_cast<S>(Limits::max()))
+            return Limits::max();
+        return static_cast<D>(value);
+    }
+    else
+    {
+        if constexpr (std::is_signed_v<S>)
+        {
+            if (value < 0)
+            {
+                if constexpr (std::is_signed_v<D>)
+                    return static_cast<std::intmax_t>(value) < static_cast<std::intmax_t>(Limits::lowest()) ?
+                           Limits::lowest() : static_cast<D>(value);
+                else
+                    return D {};
+            }
+        }
+        return static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(Limits::max()) ?
+               Limits::max() : static_cast<D>(value);
+    }
+}
+
+} // namespace
+
+void loadAsFloat(const Tensor &src, std::size_t offset, std::size_t count, float *dst)
+{
+    checkRange(src, offset, count);
+    visitDataType(src.dataType(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        auto begin = src.data<T>() + offset;
+        if constexpr (isHalf<decltype(tag)>)
+            convertHalfToFloat(begin, dst, count);
+        else if constexpr (std::is_same_v<T, float>)
+            std::memcpy(dst, begin, count * sizeof(float));
+        else
+            std::transform(begin, begin + count, dst, [](T value) { return static_cast<float>(value); });
+    });
+}
+
+void storeFromFloat(const float *src, std::size_t count, Tensor &dst, std::size_t offset)
+{
+    checkRange(dst, offset, count);
+    visitDataType(dst.dataType(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        auto begin = dst.data<T>() + offset;
+        if constexpr (isHalf<decltype(tag)>)
+            convertFloatToHalf(src, begin, count);
+        else if constexpr (std::is_same_v<T, float>)
+            std::memcpy(begin, src, count * sizeof(float));
+        else
+            std::transform(src, src + count, begin, [](float value) { return saturateCast<T>(value); });
+    });
+}
+
+const float *floatData(const Tensor &tensor, std::vector<float> &staging)
+{
+    if (tensor.dataType() == fp32)
+    {
+        checkRange(tensor, 0, 0);
+        return tensor.data<float>();
+    }
+    staging.resize(tensor.numElements());
+    loadAsFloat(tensor, 0, staging.size(), staging.data());
+    return staging.data();
+}
+
+void convert(const Tensor &src, std::size_t srcOffset, std::size_t count, Tensor &dst, std::size_t dstOffset)
+{
+    checkRange(src, srcOffset, count);
+    checkRange(dst, dstOffset, count);
+    if (src.dataType() == dst.dataType())
+    {
+        auto elementSize = dataTypeSize(src.dataType());
+        std::memcpy(static_cast<char*>(dst.data()) + dstOffset * elementSize,
+                    static_cast<const char*>(src.data()) + srcOffset * elementSize,
+                    count * elementSize);
+        return;
+    }
+    bool floatingPoint = src.dataType() == fp16 || src.dataType() == fp32 ||
+                         dst.dataType() == fp16 || dst.dataType() == fp32;
+    if (!floatingPoint)
+    {
+        visitDataType(src.dataType(), [&](auto srcTag) {
+            visitDataType(dst.dataType(), [&](auto dstTag) {
+                using S = typename decltype(srcTag)::type;
+                using D = typename decltype(dstTag)::type;
+                std::transform(src.data<S>() + srcOffset, src.data<S>() + srcOffset + count, dst.data<D>() + dstOffset,
+                               [](S value) { return saturateCast<D>(value); });
+            });
+        });
+        return;
+    }
+    // Stream through an fp32 staging block that stays in L1
+    constexpr std::size_t kBlock = 1024;
+    std::array<float, kBlock> staging;
+    for (std::size_t done = 0; done < count; done += kBlock)
+    {
+        auto chunk = std::min(kBlock, count - done);
+        loadAsFloat(src, srcOffset + done, chunk, staging.data());
+        storeFromFloat(staging.data(), chunk, dst, dstOffset + done);
+    }
+}
+
+} // kernels
+} // yt
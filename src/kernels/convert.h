@@ -0,0 +1,25 @@
+#pragma once
+
+#include <tensor.h>
+#include <cstddef>
+#include <vector>
+
+namespace yt {
+namespace kernels {
+
+// Kernels compute in fp32 registers regardless of the storage type: these read/write
+// a contiguous range of elements of a tensor through a caller-provided fp32 buffer.
+// Stores to integer types truncate toward zero and saturate; NaN stores 0.
+void loadAsFloat(const Tensor &src, std::size_t offset, std::size_t count, float *dst);
+void storeFromFloat(const float *src, std::size_t count, Tensor &dst, std::size_t offset);
+
+// fp32 data of a whole tensor: the tensor's own storage when it is fp32, staging filled with a
+// converted copy otherwise
+const float *floatData(const Tensor &tensor, std::vector<float> &staging);
+
+// Element-wise conversion of a contiguous range between two tensors of any data types; conversions to
+// integer types saturate like storeFromFloat
+void convert(const Tensor &src, std::size_t srcOffset, std::size_t count, Tensor &dst, std::size_t dstOffset);
+
+} // kernels
+} // yt
@@ -0,0 +1,82 @@
+#include "elementwise.h"
+#include "strided.h"
+#include <throw_exception.h>
+#include <algorithm>
+
+namespace yt {
+namespace kernels {
+
+Shape broadcastShapes(const Shape &a, const Shape &b)
+{
+    Shape result(std::max(a.size(), b.size()));
+    for (std::size_t i = 0; i < result.size(); i++)
+    {
+        auto x = i < a.size() ? a[a.size() - 1 - i] : 1;
+        auto y = i < b.size() ? b[b.size() - 1 - i] : 1;
+        if (x != y && x != 1 && y != 1)
+            throwException("Broadcast: incompatible dimensions " + std::to_string(x) + " and " + std::to_string(y));
+        result[result.size() - 1 - i] = x == 1 ? y : x;
+    }
+    return result;
+}
+
+Strides broadcastStrides(const Tensor &tensor, const Shape &shape)
+{
+    const auto &own = tensor.shape();
+    auto ownStrides = tensor.strides();
+    Strides result(shape.size());
+    for (std::size_t i = 0; i < own.size() && i < shape.size(); i++)
+    {
+        auto d = own.size() - 1 - i;
+        result[shape.size() - 1 - i] = own[d] == 1 ? 0 : ownStrides[d];
+    }
+    return result;
+}
+
+void add(const Tensor &a, const Tensor &b, Tensor &output)
+{
+    if (a.dataType() != fp32 || b.dataType() != fp32 || output.dataType() != fp32 || output.empty())
+        throwException("Add: expected fp32 tensors");
+    const auto &shape = output.shape();
+    if (a.layout() != Layout::nchw || b.layout() != Layout::nchw || output.layout() != Layout::nchw)
+    {
+        if (a.layout() != output.layout() || b.layout() != output.layout() || a.shape() != shape || b.shape() != shape)
+            throwException("Add: nhwc and nChw8c need inputs and output of one shape and layout");
+        // Element-wise over the storage; zero padding lanes of nChw8c sum to zero
+        auto y = output.data<float>();
+        auto x = a.data<float>();
+        auto z = b.data<float>();
+        auto count = storageElements(shape, output.layout());
+        for (std::size_t i = 0; i < count; i++)
+            y[i] = x[i] + z[i];
+        return;
+    }
+    if (broadcastShapes(a.shape(), b.shape()) != shape)
+        throwException("Add: output shape must be the broadcast of the input shapes");
+    if (shape.numElements() == 0)
+        return;
+    StridedLoop<3> loop {shape, {output.strides(), broadcastStrides(a, shape), broadcastStrides(b, shape)}};
+    auto y = output.data<float>();
+    auto x = a.data<float>();
+    auto z = b.data<float>();
+    auto length = loop.rowLength();
+    if (loop.unitRows())
+        return loop.forEachRow([x, y, z, length](const std::array<std::ptrdiff_t, 3> &offsets) {
+            auto out = y + offsets[0];
+            auto left = x + offsets[1];
+            auto right = z + offsets[2];
+            for (std::size_t i = 0; i < length; i++)
+                out[i] = left[i] + right[i];
+        });
+    std::array<std::ptrdiff_t, 3> strides {loop.rowStride(0), loop.rowStride(1), loop.rowStride(2)};
+    loop.forEachRow([x, y, z, length, &strides](const std::array<std::ptrdiff_t, 3> &offsets) {
+        for (std::size_t i = 0; i < length; i++)
+        {
+            auto j = static_cast<std::ptrdiff_t>(i);
+            y[offsets[0] + j * strides[0]] = x[offsets[1] + j * strides[1]] + z[offsets[2] + j * strides[2]];
+        }
+    });
+}
+
+} // kernels
+} // yt
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <tensor.h>
+
+namespace yt {
+namespace kernels {
+
+// Numpy-style broadcasting: shapes are aligned on their last dimension and a dimension of size 1
+// stretches to the other operand's size
+Shape broadcastShapes(const Shape &a, const Shape &b);
+// Strides that read tensor as if it had the (broadcast) shape: stretched dimensions get stride 0
+Strides broadcastStrides(const Tensor &tensor, const Shape &shape);
+
+// output = a + b with broadcasting, fp32. Inputs and output may be strided views; nothing is copied.
+// nhwc and nChw8c are supported when inputs and output share one shape and layout.
+void add(const Tensor &a, const Tensor &b, Tensor &output);
+
+} // kernels
+} // yt
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace yt {
+namespace kernels {
+
+// exp(x) by range reduction to x = n * ln2 + r, |r| <= ln2 / 2, and a degree 6 polynomial for
+// exp(r). Relative error stays below 2e-7 on [-87, 88]; inputs outside are clamped, so the result
+// is always finite and normal.
+// Every step is a single correctly rounded operation (n rounds half to even, the rest are fused
+// multiply-adds), so vector versions that repeat the same steps return bit-identical results.
+inline float fastExp(float x)
+{
+    constexpr float kLog2e = 1.44269504088896341f;
+    constexpr float kLn2Hi = 0.693359375f;
+    constexpr float kLn2Lo = -2.12194440e-4f;
+    x = x < -87.3f ? -87.3f : (x > 88.3f ? 88.3f : x);
+    auto n = std::nearbyint(x * kLog2e);
+    auto r = std::fma(-n, kLn2Hi, x);
+    r = std::fma(-n, kLn2Lo, r);
+    auto p = 1.9875691500e-4f;
+    p = std::fma(p, r, 1.3981999507e-3f);
+    p = std::fma(p, r, 8.3334519073e-3f);
+    p = std::fma(p, r, 4.1665795894e-2f);
+    p = std::fma(p, r, 1.6666665459e-1f);
+    p = std::fma(p, r, 5.0000001201e-1f);
+    p = std::fma(p, r * r, r + 1.f);
+    std::int32_t bits;
+    std::memcpy(&bits, &p, sizeof bits);
+    bits += static_cast<std::int32_t>(n) << 23;
+    std::memcpy(&p, &bits, sizeof p);
+    return p;
+}
+
+} // kernels
+} // yt
@@ -0,0 +1,144 @@
+#include "fp16.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+std::uint32_t floatBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+float bitsToFloat(std::uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+void convertHalfToFloatScalar(const half *src, float *dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        dst[i] = halfToFloat(src[i]);
+}
+
+void convertFloatToHalfScalar(const float *src, half *dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        dst[i] = floatToHalf(src[i]);
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx,f16c")]] void convertHalfToFloatF16C(const half *src, float *dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(lo));
+        _mm256_storeu_ps(dst + i + 8, _mm256_cvtph_ps(hi));
+    }
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    convertHalfToFloatScalar(src + i, dst + i, count - i);
+}
+
+[[gnu::target("avx,f16c")]] void convertFloatToHalfF16C(const float *src, half *dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        auto lo = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        auto hi = _mm256_cvtps_ph(_mm256_loadu_ps(src + i + 8), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), hi);
+    }
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    convertFloatToHalfScalar(src + i, dst + i, count - i);
+}
+
+#endif
+
+} // namespace
+
+float halfToFloat(half value)
+{
+    std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+    std::uint32_t exponent = (value >> 10) & 0x1f;
+    std::uint32_t mantissa = value & 0x3ff;
+    if (exponent == 0)
+    {
+        // Zero or subnormal: mantissa * 2^-24 is exact in fp32
+        float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        return bitsToFloat(sign | floatBits(magnitude));
+    }
+    if (exponent == 0x1f)
+        return bitsToFloat(sign | 0x7f800000 | (mantissa << 13));
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+half floatToHalf(float value)
+{
+    std::uint32_t bits = floatBits(value);
+    auto sign = static_cast<half>((bits >> 16) & 0x8000);
+    bits &= 0x7fffffff;
+    if (bits >= 0x7f800000)
+        return sign | 0x7c00 | (bits > 0x7f800000 ? 0x200 | ((bits >> 13) & 0x3ff) : 0);
+    // Everything from 65520 up rounds to infinity
+    if (bits >= 0x477ff000)
+        return sign | 0x7c00;
+    if (bits < 0x38800000)
+    {
+        // Result is subnormal: let the FPU round by aligning the mantissa at 2^-24 ulp
+        auto aligned = floatBits(bitsToFloat(bits) + 0.5f);
+        return sign | static_cast<half>(aligned - 0x3f000000);
+    }
+    std::uint32_t mantissaOdd = (bits >> 13) & 1;
+    // Rebias the exponent (127 - 15) and round to nearest even in one add
+    bits += 0xc8000fffu + mantissaOdd;
+    return sign | static_cast<half>(bits >> 13);
+}
+
+bool hasF16C()
+{
+#ifdef YT_HAS_X86_DISPATCH
+    static const bool supported = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void convertHalfToFloat(const half *src, float *dst, std::size_t count)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasF16C())
+        return convertHalfToFloatF16C(src, dst, count);
+#endif
+    convertHalfToFloatScalar(src, dst, count);
+}
+
+void convertFloatToHalf(const float *src, half *dst, std::size_t count)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasF16C())
+        return convertFloatToHalfF16C(src, dst, count);
+#endif
+    convertFloatToHalfScalar(src, dst, count);
+}
+
+} // kernels
+} // yt
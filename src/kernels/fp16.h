@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yt {
+namespace kernels {
+
+using half = std::uint16_t;
+
+// IEEE 754 binary16 <-> binary32, round to nearest even; NaNs stay (quiet) NaNs
+float halfToFloat(half value);
+half floatToHalf(float value);
+
+// Bulk conversions use F16C when the host supports it and fall back to the scalar routines otherwise
+void convertHalfToFloat(const half *src, float *dst, std::size_t count);
+void convertFloatToHalf(const float *src, half *dst, std::size_t count);
+
+bool hasF16C();
+
+} // kernels
+} // yt
@@ -0,0 +1,82 @@
+#include "gemm.h"
+#include "autotuner.h"
+#include <algorithm>
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+// Below this many multiply-adds timer noise exceeds any difference between tilings
+constexpr std::size_t kMinTunedWork = std::size_t {1} << 16;
+
+} // namespace
+
+std::string GemmTiling::name() const
+{
+    return "n" + std::to_string(blockN) + "k" + std::to_string(blockK);
+}
+
+const std::vector<GemmTiling> &gemmTilings()
+{
+    static const std::vector<GemmTiling> tilings {
+        {256, 128}, {64, 64}, {64, 128}, {64, 256}, {128, 64}, {128, 128}, {128, 256},
+        {256, 64}, {256, 256}, {512, 64}, {512, 128}, {512, 256},
+    };
+    return tilings;
+}
+
+const GemmTiling &tunedGemmTiling(std::size_t m, std::size_t n, std::size_t k)
+{
+    const auto &tilings = gemmTilings();
+    if (m * n * k < kMinTunedWork)
+        return tilings.front();
+    static const auto names = []() {
+        std::vector<std::string> names;
+        for (const auto &tiling : gemmTilings())
+            names.push_back(tiling.name());
+        return names;
+    }();
+    // Timing does not depend on the values, so zeroed operands stand in for the real ones;
+    // they are only allocated when the key has to be benchmarked
+    std::vector<float> a, b, c;
+    auto choice = Autotuner::instance().select({"gemm", {m, n, k}, fp32}, names, [&](std::size_t candidate) {
+        a.resize(m * k);
+        b.resize(k * n);
+        c.resize(m * n);
+        gemm(m, n, k, a.data(), b.data(), c.data(), false, tilings[candidate]);
+    });
+    return tilings[choice];
+}
+
+void gemm(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c, bool accumulate,
+          const GemmTiling &tiling)
+{
+    // The inner loop runs along contiguous rows of B and C
+    auto blockN = std::max<std::size_t>(tiling.blockN, 1);
+    auto blockK = std::max<std::size_t>(tiling.blockK, 1);
+    if (!accumulate)
+        std::fill(c, c + m * n, 0.f);
+    for (std::size_t j0 = 0; j0 < n; j0 += blockN)
+    {
+        auto j1 = std::min(n, j0 + blockN);
+        for (std::size_t p0 = 0; p0 < k; p0 += blockK)
+        {
+            auto p1 = std::min(k, p0 + blockK);
+            for (std::size_t i = 0; i < m; i++)
+            {
+                auto cRow = c + i * n;
+                for (auto p = p0; p < p1; p++)
+                {
+                    auto aValue = a[i * k + p];
+                    auto bRow = b + p * n;
+                    for (auto j = j0; j < j1; j++)
+                        cRow[j] += aValue * bRow[j];
+                }
+            }
+        }
+    }
+}
+
+} // kernels
+} // yt
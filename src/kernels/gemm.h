@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace yt {
+namespace kernels {
+
+// Cache blocking of B: blockK rows by blockN columns are reused across all rows of A
+struct GemmTiling
+{
+    std::size_t blockN {256};
+    std::size_t blockK {128};
+
+    std::string name() const;
+};
+
+// Variants the autotuner chooses from; the first is the untuned default
+const std::vector<GemmTiling> &gemmTilings();
+
+// Tiling tuned for (m, n, k) on this CPU model, see Autotuner. An unseen shape is benchmarked on scratch
+// operands, so kernels resolve their tiling once when compiled rather than on every call.
+const GemmTiling &tunedGemmTiling(std::size_t m, std::size_t n, std::size_t k);
+
+// Row-major C[m, n] = A[m, k] * B[k, n] (+ C when accumulate is set).
+// All tilings sum in the same order, so the result does not depend on the choice.
+void gemm(std::size_t m, std::size_t n, std::size_t k, const float *a, const float *b, float *c,
+          bool accumulate = false, const GemmTiling &tiling = gemmTilings().front());
+
+} // kernels
+} // yt
@@ -0,0 +1,412 @@
+#include "layers.h"
+#include "convert.h"
+#include "gemm.h"
+#include <throw_exception.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+void checkFloatOutput(const Tensor &output, std::size_t numElements, const char *layer)
+{
+    if (output.dataType() != fp32 || output.numElements() != numElements || output.empty())
+        throwException(std::string{layer} + ": output must be an fp32 tensor of matching size");
+}
+
+void checkLayouts(const Tensor &input, const Tensor &output, const char *layer)
+{
+    if (input.layout() != output.layout())
+        throwException(std::string{layer} + ": output layout must match the input layout");
+    if (input.layout() != Layout::nchw && (input.dataType() != fp32 || input.shape().size() != 4))
+        throwException(std::string{layer} + ": nhwc and nChw8c inputs must be 4D fp32 tensors");
+}
+
+// nhwc and nChw8c are both [N, groups, H, W, lanes]: one group of C lanes, or C/8 groups of 8 lanes
+std::pair<std::size_t, std::size_t> pixelMajorGroups(const Tensor &tensor)
+{
+    auto channels = tensor.shape()[1];
+    if (tensor.layout() == Layout::nhwc)
+        return {1, channels};
+    return {(channels + kChannelBlock - 1) / kChannelBlock, kChannelBlock};
+}
+
+// Blocked weights [O/8, C/8, KH, KW, 8 in, 8 out], zero-padded, so that one vector load yields a weight
+// for eight output channels
+std::vector<float> packConvWeights(const float *w, std::size_t outChannels, std::size_t channels,
+                                   std::size_t kernelH, std::size_t kernelW)
+{
+    auto outBlocks = (outChannels + kChannelBlock - 1) / kChannelBlock;
+    auto inBlocks = (channels + kChannelBlock - 1) / kChannelBlock;
+    auto taps = kernelH * kernelW;
+    std::vector<float> packed(outBlocks * inBlocks * taps * kChannelBlock * kChannelBlock);
+    for (std::size_t o = 0; o < outChannels; o++)
+        for (std::size_t c = 0; c < channels; c++)
+            for (std::size_t tap = 0; tap < taps; tap++)
+            {
+                auto block = ((o / kChannelBlock) * inBlocks + c / kChannelBlock) * taps + tap;
+                packed[(block * kChannelBlock + c % kChannelBlock) * kChannelBlock + o % kChannelBlock] =
+                    w[(o * channels + c) * taps + tap];
+            }
+    return packed;
+}
+
+struct BlockedConvShape
+{
+    std::size_t inBlocks, height, width, kernelH, kernelW, outH, outW, stride;
+    std::ptrdiff_t padding;
+};
+
+// Output rows are produced kPixelBlock pixels at a time so every weight vector loaded serves several pixels
+constexpr std::size_t kPixelBlock = 4;
+
+// One output row of one output channel block; weights point at [C/8, KH, KW, 8, 8] of that block
+void convRowBlockedScalar(const float *image, const float *weights, const float *bias, std::size_t oh,
+                          const BlockedConvShape &s, float *row)
+{
+    for (std::size_t ow0 = 0; ow0 < s.outW; ow0 += kPixelBlock)
+    {
+        auto pixelsHere = std::min(kPixelBlock, s.outW - ow0);
+        float acc[kPixelBlock][kChannelBlock];
+        for (std::size_t j = 0; j < pixelsHere; j++)
+            std::copy(bias, bias + kChannelBlock, acc[j]);
+        for (std::size_t cb = 0; cb < s.inBlocks; cb++)
+            for (std::size_t kh = 0; kh < s.kernelH; kh++)
+            {
+                auto ih = static_cast<std::ptrdiff_t>(oh * s.stride + kh) - s.padding;
+                if (ih < 0 || ih >= static_cast<std::ptrdiff_t>(s.height))
+                    continue;
+                for (std::size_t kw = 0; kw < s.kernelW; kw++)
+                {
+                    auto w = weights + ((cb * s.kernelH + kh) * s.kernelW + kw) * kChannelBlock * kChannelBlock;
+                    for (std::size_t j = 0; j < pixelsHere; j++)
+                    {
+                        auto iw = static_cast<std::ptrdiff_t>((ow0 + j) * s.stride + kw) - s.padding;
+                        if (iw < 0 || iw >= static_cast<std::ptrdiff_t>(s.width))
+                            continue;
+                        auto x = image + ((cb * s.height + ih) * s.width + iw) * kChannelBlock;
+                        for (std::size_t ic = 0; ic < kChannelBlock; ic++)
+                            for (std::size_t oc = 0; oc < kChannelBlock; oc++)
+                                acc[j][oc] += x[ic] * w[ic * kChannelBlock + oc];
+                    }
+                }
+            }
+        for (std::size_t j = 0; j < pixelsHere; j++)
+            std::copy(acc[j], acc[j] + kChannelBlock, row + (ow0 + j) * kChannelBlock);
+    }
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx2,fma")]] void convRowBlockedAvx2(const float *image, const float *weights, const float *bias,
+                                                    std::size_t oh, const BlockedConvShape &s, float *row)
+{
+    auto biasVector = _mm256_loadu_ps(bias);
+    for (std::size_t ow0 = 0; ow0 < s.outW; ow0 += kPixelBlock)
+    {
+        auto pixelsHere = std::min(kPixelBlock, s.outW - ow0);
+        __m256 acc[kPixelBlock] {biasVector, biasVector, biasVector, biasVector};
+        for (std::size_t cb = 0; cb < s.inBlocks; cb++)
+            for (std::size_t kh = 0; kh < s.kernelH; kh++)
+            {
+                auto ih = static_cast<std::ptrdiff_t>(oh * s.stride + kh) - s.padding;
+                if (ih < 0 || ih >= static_cast<std::ptrdiff_t>(s.height))
+                    continue;
+                for (std::size_t kw = 0; kw < s.kernelW; kw++)
+                {
+                    auto w = weights + ((cb * s.kernelH + kh) * s.kernelW + kw) * kChannelBlock * kChannelBlock;
+                    __m256 wv[kChannelBlock];
+                    for (std::size_t ic = 0; ic < kChannelBlock; ic++)
+                        wv[ic] = _mm256_loadu_ps(w + ic * kChannelBlock);
+                    for (std::size_t j = 0; j < pixelsHere; j++)
+                    {
+                        auto iw = static_cast<std::ptrdiff_t>((ow0 + j) * s.stride + kw) - s.padding;
+                        if (iw < 0 || iw >= static_cast<std::ptrdiff_t>(s.width))
+                            continue;
+                        auto x = image + ((cb * s.height + ih) * s.width + iw) * kChannelBlock;
+                        for (std::size_t ic = 0; ic < kChannelBlock; ic++)
+                            acc[j] = _mm256_fmadd_ps(_mm256_broadcast_ss(x + ic), wv[ic], acc[j]);
+                    }
+                }
+            }
+        for (std::size_t j = 0; j < pixelsHere; j++)
+            _mm256_storeu_ps(row + (ow0 + j) * kChannelBlock, acc[j]);
+    }
+}
+
+bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#endif
+
+void convRowBlocked(const float *image, const float *weights, const float *bias, std::size_t oh,
+                    const BlockedConvShape &s, float *row)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasAvx2())
+        return convRowBlockedAvx2(image, weights, bias, oh, s, row);
+#endif
+    convRowBlockedScalar(image, weights, bias, oh, s, row);
+}
+
+// Direct convolution of nChw8c input into nChw8c output
+void conv2dBlocked(const Tensor &input, const float *w, const float *b, std::size_t outChannels,
+                   const BlockedConvShape &s, Tensor &output)
+{
+    auto batch = input.shape()[0], channels = input.shape()[1];
+    auto outBlocks = (outChannels + kChannelBlock - 1) / kChannelBlock;
+    auto packed = packConvWeights(w, outChannels, channels, s.kernelH, s.kernelW);
+    std::vector<float> paddedBias(outBlocks * kChannelBlock);
+    std::copy(b, b + outChannels, paddedBias.begin());
+    auto blockWeights = s.inBlocks * s.kernelH * s.kernelW * kChannelBlock * kChannelBlock;
+    auto inImage = s.inBlocks * s.height * s.width * kChannelBlock;
+    auto outPlane = s.outH * s.outW * kChannelBlock;
+    for (std::size_t n = 0; n < batch; n++)
+        for (std::size_t ob = 0; ob < outBlocks; ob++)
+            for (std::size_t oh = 0; oh < s.outH; oh++)
+                convRowBlocked(input.data<float>() + n * inImage, packed.data() + ob * blockWeights,
+                               paddedBias.data() + ob * kChannelBlock, oh, s,
+                               output.data<float>() + (n * outBlocks + ob) * outPlane + oh * s.outW * kChannelBlock);
+}
+
+} // namespace
+
+std::size_t convOutputSize(std::size_t input, std::size_t kernel, std::size_t stride, std::size_t padding)
+{
+    if (!stride || input + 2 * padding < kernel)
+        throwException("Window of size " + std::to_string(kernel) + " doesn't fit input of size " + std::to_string(input));
+    return (input + 2 * padding - kernel) / stride + 1;
+}
+
+void dense(const Tensor &input, const Tensor &weights, const Tensor &bias, Tensor &output, const GemmTiling &tiling)
+{
+    auto batch = input.shape().front();
+    auto inFeatures = input.numElements() / std::max<std::size_t>(batch, 1);
+    if (weights.shape().size() != 2 || weights.shape()[0] != inFeatures || bias.numElements() != weights.shape()[1])
+        throwException("Dense: weights must be [in, out] and bias [out]");
+    auto outFeatures = weights.shape()[1];
+    checkFloatOutput(output, batch * outFeatures, "Dense");
+    std::vector<float> inputStaging, weightsStaging, biasStaging;
+    auto x = floatData(input, inputStaging);
+    auto w = floatData(weights, weightsStaging);
+    auto b = floatData(bias, biasStaging);
+    auto y = output.data<float>();
+    for (std::size_t row = 0; row < batch; row++)
+        std::copy(b, b + outFeatures, y + row * outFeatures);
+    gemm(batch, outFeatures, inFeatures, x, w, y, true, tiling);
+}
+
+void conv2d(const Tensor &input, const Tensor &weights, const Tensor &bias, const Conv2DParams &params, Tensor &output,
+            const GemmTiling &tiling)
+{
+    const auto &inShape = input.shape();
+    const auto &wShape = weights.shape();
+    if (inShape.size() != 4 || wShape.size() != 4 || wShape[1] != inShape[1] || bias.numElements() != wShape[0])
+        throwException("Conv2D: expected NCHW input, [O, C, KH, KW] weights and [O] bias");
+    auto batch = inShape[0], channels = inShape[1], height = inShape[2], width = inShape[3];
+    auto outChannels = wShape[0], kernelH = wShape[2], kernelW = wShape[3];
+    auto outH = convOutputSize(height, kernelH, params.stride, params.padding);
+    auto outW = convOutputSize(width, kernelW, params.stride, params.padding);
+    checkFloatOutput(output, batch * outChannels * outH * outW, "Conv2D");
+    checkLayouts(input, output, "Conv2D");
+    std::vector<float> inputStaging, weightsStaging, biasStaging;
+    auto w = floatData(weights, weightsStaging);
+    auto b = floatData(bias, biasStaging);
+    if (input.layout() == Layout::nChw8c)
+    {
+        BlockedConvShape shape {(channels + kChannelBlock - 1) / kChannelBlock, height, width, kernelH, kernelW,
+                                outH, outW, params.stride, static_cast<std::ptrdiff_t>(params.padding)};
+        return conv2dBlocked(input, w, b, outChannels, shape, output);
+    }
+    if (input.layout() != Layout::nchw)
+        throwException("Conv2D: only nchw and nChw8c inputs are supported");
+    auto x = floatData(input, inputStaging);
+
+    // im2col: one column per output pixel, one row per (channel, kh, kw) tap, so the convolution
+    // of an image becomes weights[O, C*KH*KW] * columns[C*KH*KW, OH*OW]
+    auto padding = static_cast<std::ptrdiff_t>(params.padding);
+    auto patchSize = channels * kernelH * kernelW;
+    auto numPixels = outH * outW;
+    std::vector<float> columns(patchSize * numPixels);
+    for (std::size_t n = 0; n < batch; n++)
+    {
+        auto image = x + n * channels * height * width;
+        for (std::size_t c = 0; c < channels; c++)
+            for (std::size_t kh = 0; kh < kernelH; kh++)
+                for (std::size_t kw = 0; kw < kernelW; kw++)
+                {
+                    auto column = columns.data() + ((c * kernelH + kh) * kernelW + kw) * numPixels;
+                    for (std::size_t oh = 0; oh < outH; oh++)
+                    {
+                        auto ih = static_cast<std::ptrdiff_t>(oh * params.stride + kh) - padding;
+                        for (std::size_t ow = 0; ow < outW; ow++)
+                        {
+                            auto iw = static_cast<std::ptrdiff_t>(ow * params.stride + kw) - padding;
+                            bool inside = ih >= 0 && iw >= 0 && ih < static_cast<std::ptrdiff_t>(height) &&
+                                          iw < static_cast<std::ptrdiff_t>(width);
+                            column[oh * outW + ow] = inside ? image[(c * height + ih) * width + iw] : 0.f;
+                        }
+                    }
+                }
+        auto y = output.data<float>() + n * outChannels * numPixels;
+        for (std::size_t o = 0; o < outChannels; o++)
+            std::fill(y + o * numPixels, y + (o + 1) * numPixels, b[o]);
+        gemm(outChannels, numPixels, patchSize, w, columns.data(), y, true, tiling);
+    }
+}
+
+void pool2d(const Tensor &input, const Pool2DParams &params, Tensor &output)
+{
+    const auto &inShape = input.shape();
+    if (inShape.size() != 4)
+        throwException("Pool2D: expected NCHW input");
+    auto planes = inShape[0] * inShape[1], height = inShape[2], width = inShape[3];
+    auto outH = convOutputSize(height, params.kernelSize, params.stride, params.padding);
+    auto outW = convOutputSize(width, params.kernelSize, params.stride, params.padding);
+    checkFloatOutput(output, planes * outH * outW, "Pool2D");
+    checkLayouts(input, output, "Pool2D");
+    std::vector<float> staging;
+    auto x = floatData(input, staging);
+    auto y = output.data<float>();
+    auto padding = static_cast<std::ptrdiff_t>(params.padding);
+    auto window = static_cast<std::ptrdiff_t>(params.kernelSize);
+    if (input.layout() != Layout::nchw)
+    {
+        // Same windows, but every tap is a run of lanes that the compiler vectorizes
+        auto groups = pixelMajorGroups(input);
+        auto lanes = groups.second;
+        for (std::size_t image = 0; image < inShape[0] * groups.first; image++)
+        {
+            auto src = x + image * height * width * lanes;
+            auto dst = y + image * outH * outW * lanes;
+            for (std::size_t oh = 0; oh < outH; oh++)
+            {
+                auto start = static_cast<std::ptrdiff_t>(oh * params.stride) - padding;
+                auto h0 = std::max<std::ptrdiff_t>(0, start);
+                auto h1 = std::min<std::ptrdiff_t>(height, start + window);
+                for (std::size_t ow = 0; ow < outW; ow++)
+                {
+                    auto columnStart = static_cast<std::ptrdiff_t>(ow * params.stride) - padding;
+                    auto w0 = std::max<std::ptrdiff_t>(0, columnStart);
+                    auto w1 = std::min<std::ptrdiff_t>(width, columnStart + window);
+                    auto out = dst + (oh * outW + ow) * lanes;
+                    std::fill(out, out + lanes,
+                              params.type == PoolingType::max ? -std::numeric_limits<float>::infinity() : 0.f);
+                    for (auto h = h0; h < h1; h++)
+                        for (auto w = w0; w < w1; w++)
+                        {
+                            auto in = src + (h * width + w) * lanes;
+                            if (params.type == PoolingType::max)
+                                for (std::size_t lane = 0; lane < lanes; lane++)
+                                    out[lane] = std::max(out[lane], in[lane]);
+                            else
+                                for (std::size_t lane = 0; lane < lanes; lane++)
+                                    out[lane] += in[lane];
+                        }
+                    if (params.type == PoolingType::average)
+                    {
+                        auto scale = 1.f / std::max<std::ptrdiff_t>(1, (h1 - h0) * (w1 - w0));
+                        for (std::size_t lane = 0; lane < lanes; lane++)
+                            out[lane] *= scale;
+                    }
+                }
+            }
+        }
+        return;
+    }
+    for (std::size_t plane = 0; plane < planes; plane++)
+    {
+        auto src = x + plane * height * width;
+        for (std::size_t oh = 0; oh < outH; oh++)
+        {
+            auto start = static_cast<std::ptrdiff_t>(oh * params.stride) - padding;
+            auto h0 = std::max<std::ptrdiff_t>(0, start);
+            auto h1 = std::min<std::ptrdiff_t>(height, start + window);
+            for (std::size_t ow = 0; ow < outW; ow++)
+            {
+                auto columnStart = static_cast<std::ptrdiff_t>(ow * params.stride) - padding;
+                auto w0 = std::max<std::ptrdiff_t>(0, columnStart);
+                auto w1 = std::min<std::ptrdiff_t>(width, columnStart + window);
+                float acc = params.type == PoolingType::max ? -std::numeric_limits<float>::infinity() : 0.f;
+                for (auto h = h0; h < h1; h++)
+                    for (auto w = w0; w < w1; w++)
+                        acc = params.type == PoolingType::max ? std::max(acc, src[h * width + w]) : acc + src[h * width + w];
+                if (params.type == PoolingType::average)
+                    acc /= std::max<std::ptrdiff_t>(1, (h1 - h0) * (w1 - w0));
+                y[(plane * outH + oh) * outW + ow] = acc;
+            }
+        }
+    }
+}
+
+void batchNorm(const Tensor &input, const Tensor &scale, const Tensor &shift, const Tensor &mean,
+               const Tensor &variance, float epsilon, Tensor &output)
+{
+    const auto &shape = input.shape();
+    if (shape.size() < 2)
+        throwException("BatchNorm: expected [N, C, ...] input");
+    auto channels = shape[1];
+    for (auto parameter : {&scale, &shift, &mean, &variance})
+        if (parameter->numElements() != channels)
+            throwException("BatchNorm: parameters must hold one value per channel");
+    checkFloatOutput(output, input.numElements(), "BatchNorm");
+    checkLayouts(input, output, "BatchNorm");
+    std::vector<float> multiplier(channels), offset(channels);
+    loadAsFloat(scale, 0, channels, multiplier.data());
+    loadAsFloat(shift, 0, channels, offset.data());
+    std::vector<float> meanValues(channels), varianceValues(channels);
+    loadAsFloat(mean, 0, channels, meanValues.data());
+    loadAsFloat(variance, 0, channels, varianceValues.data());
+    for (std::size_t c = 0; c < channels; c++)
+    {
+        multiplier[c] /= std::sqrt(varianceValues[c] + epsilon);
+        offset[c] -= meanValues[c] * multiplier[c];
+    }
+    std::vector<float> staging;
+    auto x = floatData(input, staging);
+    auto y = output.data<float>();
+    if (input.layout() != Layout::nchw)
+    {
+        // Per-lane parameters; padding lanes of nChw8c get zeros and stay zero
+        auto groups = pixelMajorGroups(input);
+        auto lanes = groups.second;
+        std::vector<float> laneMultiplier(groups.first * lanes), laneOffset(groups.first * lanes);
+        std::copy(multiplier.begin(), multiplier.end(), laneMultiplier.begin());
+        std::copy(offset.begin(), offset.end(), laneOffset.begin());
+        auto pixels = shape[2] * shape[3];
+        for (std::size_t n = 0; n < shape[0]; n++)
+            for (std::size_t group = 0; group < groups.first; group++)
+            {
+                auto m = laneMultiplier.data() + group * lanes;
+                auto o = laneOffset.data() + group * lanes;
+                auto base = (n * groups.first + group) * pixels * lanes;
+                for (std::size_t p = 0; p < pixels; p++)
+                    for (std::size_t lane = 0; lane < lanes; lane++)
+                        y[base + p * lanes + lane] = x[base + p * lanes + lane] * m[lane] + o[lane];
+            }
+        return;
+    }
+    auto inner = input.numElements() / std::max<std::size_t>(shape[0] * channels, 1);
+    for (std::size_t n = 0; n < shape[0]; n++)
+        for (std::size_t c = 0; c < channels; c++)
+        {
+            auto base = (n * channels + c) * inner;
+            for (std::size_t i = 0; i < inner; i++)
+                y[base + i] = x[base + i] * multiplier[c] + offset[c];
+        }
+}
+
+} // kernels
+} // yt
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "gemm.h"
+#include <tensor.h>
+#include <cstddef>
+
+namespace yt {
+namespace kernels {
+
+struct Conv2DParams
+{
+    std::size_t stride {1};
+    std::size_t padding {0};
+};
+
+enum class PoolingType
+{
+    max,
+    average,
+};
+
+struct Pool2DParams
+{
+    PoolingType type {PoolingType::max};
+    std::size_t kernelSize {2};
+    std::size_t stride {2};
+    std::size_t padding {0};
+};
+
+std::size_t convOutputSize(std::size_t input, std::size_t kernel, std::size_t stride, std::size_t padding);
+
+// All layers read inputs of any floating point type and write fp32 outputs.
+// Layers built on gemm take its tiling from the caller, see tunedGemmTiling for the shapes they use.
+// output[N, M] = input[N, K] * weights[K, M] + bias[M]; gemm of (N, M, K)
+void dense(const Tensor &input, const Tensor &weights, const Tensor &bias, Tensor &output,
+           const GemmTiling &tiling = gemmTilings().front());
+// The 4D layers below write their output in the layout of their input; layouts other than nchw need fp32 inputs.
+// NCHW or nChw8c input, weights [O, C, KH, KW], bias [O], output [N, O, OH, OW].
+// NCHW runs one gemm of (O, OH*OW, C*KH*KW) per image; nChw8c does not use gemm.
+void conv2d(const Tensor &input, const Tensor &weights, const Tensor &bias, const Conv2DParams &params, Tensor &output,
+            const GemmTiling &tiling = gemmTilings().front());
+// Any layout; average pooling divides by the number of taps inside the image
+void pool2d(const Tensor &input, const Pool2DParams &params, Tensor &output);
+// Inference batch normalization over axis 1 of [N, C, ...], any layout for 4D inputs
+void batchNorm(const Tensor &input, const Tensor &scale, const Tensor &shift, const Tensor &mean,
+               const Tensor &variance, float epsilon, Tensor &output);
+
+} // kernels
+} // yt
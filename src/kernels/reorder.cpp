@@ -0,0 +1,147 @@
+#include "reorder.h"
+#include <throw_exception.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+void transposeScalar(const float *src, std::size_t rows, std::size_t cols, std::size_t srcStride,
+                     float *dst, std::size_t dstStride)
+{
+    for (std::size_t r = 0; r < rows; r++)
+        for (std::size_t c = 0; c < cols; c++)
+            dst[c * dstStride + r] = src[r * srcStride + c];
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx2")]] void transposeTile8x8(const float *src, std::size_t srcStride, float *dst, std::size_t dstStride)
+{
+    __m256 r[8], t[8];
+    for (int i = 0; i < 8; i++)
+        r[i] = _mm256_loadu_ps(src + i * srcStride);
+    for (int i = 0; i < 8; i += 2)
+    {
+        t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4)
+    {
+        r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    // Rows 0-3 hold the low halves of the output rows, rows 4-7 the high halves
+    for (int i = 0; i < 4; i++)
+    {
+        _mm256_storeu_ps(dst + i * dstStride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+        _mm256_storeu_ps(dst + (i + 4) * dstStride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+    }
+}
+
+[[gnu::target("avx2")]] void transposeAvx2(const float *src, std::size_t rows, std::size_t cols, std::size_t srcStride,
+                                           float *dst, std::size_t dstStride)
+{
+    auto fullRows = rows / 8 * 8;
+    auto fullCols = cols / 8 * 8;
+    for (std::size_t r = 0; r < fullRows; r += 8)
+        for (std::size_t c = 0; c < fullCols; c += 8)
+            transposeTile8x8(src + r * srcStride + c, srcStride, dst + c * dstStride + r, dstStride);
+    transposeScalar(src + fullCols, fullRows, cols - fullCols, srcStride, dst + fullCols * dstStride, dstStride);
+    transposeScalar(src + fullRows * srcStride, rows - fullRows, cols, srcStride, dst + fullRows, dstStride);
+}
+
+bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif
+
+// One channel block of an nhwc image to and from nChw8c: count channels of every pixel, pixelStride
+// apart on the nhwc side and kChannelBlock apart on the blocked side
+void packBlock(const float *src, std::size_t count, std::size_t pixels, std::size_t pixelStride, float *dst)
+{
+    for (std::size_t p = 0; p < pixels; p++)
+    {
+        std::copy(src + p * pixelStride, src + p * pixelStride + count, dst + p * kChannelBlock);
+        std::fill(dst + p * kChannelBlock + count, dst + (p + 1) * kChannelBlock, 0.f);
+    }
+}
+
+void unpackBlock(const float *src, std::size_t count, std::size_t pixels, float *dst, std::size_t pixelStride)
+{
+    for (std::size_t p = 0; p < pixels; p++)
+        std::copy(src + p * kChannelBlock, src + p * kChannelBlock + count, dst + p * pixelStride);
+}
+
+} // namespace
+
+void transpose(const float *src, std::size_t rows, std::size_t cols, std::size_t srcStride,
+               float *dst, std::size_t dstStride)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasAvx2())
+        return transposeAvx2(src, rows, cols, srcStride, dst, dstStride);
+#endif
+    transposeScalar(src, rows, cols, srcStride, dst, dstStride);
+}
+
+void reorder(const Tensor &src, Tensor &dst)
+{
+    const auto &shape = src.shape();
+    if (src.dataType() != fp32 || dst.dataType() != fp32 || shape.size() != 4 || dst.shape() != shape ||
+        src.empty() || dst.empty() || !src.isContiguous() || !dst.isContiguous())
+        throwException("Reorder: expected contiguous fp32 4D tensors of the same shape");
+    if (src.layout() == dst.layout())
+    {
+        std::memcpy(dst.data(), src.data(), src.sizeInBytes());
+        return;
+    }
+    auto batch = shape[0], channels = shape[1], pixels = shape[2] * shape[3];
+    auto blocks = (channels + kChannelBlock - 1) / kChannelBlock;
+    auto srcImage = storageElements(shape, src.layout()) / std::max<std::size_t>(batch, 1);
+    auto dstImage = storageElements(shape, dst.layout()) / std::max<std::size_t>(batch, 1);
+    for (std::size_t n = 0; n < batch; n++)
+    {
+        auto x = src.data<float>() + n * srcImage;
+        auto y = dst.data<float>() + n * dstImage;
+        if (src.layout() == Layout::nchw && dst.layout() == Layout::nhwc)
+            transpose(x, channels, pixels, pixels, y, channels);
+        else if (src.layout() == Layout::nhwc && dst.layout() == Layout::nchw)
+            transpose(x, pixels, channels, channels, y, pixels);
+        else
+            for (std::size_t block = 0; block < blocks; block++)
+            {
+                auto first = block * kChannelBlock;
+                auto count = std::min(kChannelBlock, channels - first);
+                auto offset = block * pixels * kChannelBlock;
+                if (dst.layout() == Layout::nChw8c && src.layout() == Layout::nchw)
+                {
+                    transpose(x + first * pixels, count, pixels, pixels, y + offset, kChannelBlock);
+                    if (count < kChannelBlock)
+                        for (std::size_t p = 0; p < pixels; p++)
+                            std::fill(y + offset + p * kChannelBlock + count, y + offset + (p + 1) * kChannelBlock, 0.f);
+                }
+                else if (dst.layout() == Layout::nChw8c)
+                    packBlock(x + first, count, pixels, channels, y + offset);
+                else if (dst.layout() == Layout::nchw)
+                    transpose(x + offset, pixels, count, kChannelBlock, y + first * pixels, pixels);
+                else
+                    unpackBlock(x + offset, count, pixels, y + first, channels);
+            }
+    }
+}
+
+} // kernels
+} // yt
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <tensor.h>
+#include <cstddef>
+
+namespace yt {
+namespace kernels {
+
+// dst[c, r] = src[r, c] for an rows x cols block; strides are in elements
+void transpose(const float *src, std::size_t rows, std::size_t cols, std::size_t srcStride,
+               float *dst, std::size_t dstStride);
+
+// Copies a 4D fp32 tensor into dst, which has the same logical shape and any layout.
+// Padding channels of nChw8c destinations are zeroed.
+void reorder(const Tensor &src, Tensor &dst);
+
+} // kernels
+} // yt
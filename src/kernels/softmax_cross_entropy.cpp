@@ -0,0 +1,168 @@
+#include "softmax_cross_entropy.h"
+#include "convert.h"
+#include "fast_exp.h"
+#include <runtime/thread_pool.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+float rowMaxScalar(const float *row, std::size_t count)
+{
+    auto result = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < count; i++)
+        result = std::max(result, row[i]);
+    return result;
+}
+
+// dst[i] = exp(src[i] - shift); returns the sum of dst
+float shiftedExpScalar(const float *src, float *dst, std::size_t count, float shift)
+{
+    float sum {};
+    for (std::size_t i = 0; i < count; i++)
+        sum += dst[i] = fastExp(src[i] - shift);
+    return sum;
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx2,fma")]] float rowMaxAvx2(const float *row, std::size_t count)
+{
+    auto result = -std::numeric_limits<float>::infinity();
+    std::size_t i = 0;
+    if (count >= 8)
+    {
+        auto acc = _mm256_loadu_ps(row);
+        for (i = 8; i + 8 <= count; i += 8)
+            acc = _mm256_max_ps(acc, _mm256_loadu_ps(row + i));
+        auto half = _mm_max_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+        result = _mm_cvtss_f32(half);
+    }
+    return std::max(result, rowMaxScalar(row + i, count - i));
+}
+
+// fastExp step for step, eight lanes at a time, so both paths agree bit for bit
+[[gnu::target("avx2,fma")]] inline __m256 fastExpAvx2(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-87.3f)), _mm256_set1_ps(88.3f));
+    auto n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    auto r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+    auto p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.f)));
+    auto scale = _mm256_slli_epi32(_mm256_cvtps_epi32(n), 23);
+    return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(p), scale));
+}
+
+[[gnu::target("avx2,fma")]] float shiftedExpAvx2(const float *src, float *dst, std::size_t count, float shift)
+{
+    auto shiftVector = _mm256_set1_ps(shift);
+    auto acc = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto e = fastExpAvx2(_mm256_sub_ps(_mm256_loadu_ps(src + i), shiftVector));
+        _mm256_storeu_ps(dst + i, e);
+        acc = _mm256_add_ps(acc, e);
+    }
+    auto half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    return _mm_cvtss_f32(half) + shiftedExpScalar(src + i, dst + i, count - i, shift);
+}
+
+bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#endif
+
+float rowMax(const float *row, std::size_t count)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasAvx2())
+        return rowMaxAvx2(row, count);
+#endif
+    return rowMaxScalar(row, count);
+}
+
+float shiftedExp(const float *src, float *dst, std::size_t count, float shift)
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasAvx2())
+        return shiftedExpAvx2(src, dst, count, shift);
+#endif
+    return shiftedExpScalar(src, dst, count, shift);
+}
+
+} // namespace
+
+void softmaxCrossEntropy(const Tensor &logits, const Tensor &labels, Tensor &loss, Tensor *gradient,
+                         runtime::ThreadPool *pool)
+{
+    if (logits.shape().size() != 2 || !logits.isContiguous())
+        throwException("SoftmaxCrossEntropy: logits must be a contiguous [batch, classes] tensor");
+    auto batch = logits.shape()[0];
+    auto classes = logits.shape()[1];
+    if (labels.numElements() != batch || loss.numElements() != batch || loss.dataType() != fp32)
+        throwException("SoftmaxCrossEntropy: labels and loss must hold one element per row, loss in fp32");
+    if (gradient && (gradient->dataType() != fp32 || gradient->numElements() != logits.numElements()))
+        throwException("SoftmaxCrossEntropy: gradient must be fp32 and shaped like logits");
+
+    auto body = [&](std::size_t begin, std::size_t end) {
+        std::vector<float> labelValues(end - begin);
+        loadAsFloat(labels, begin, end - begin, labelValues.data());
+        // fp32 logits are read in place; other types go through one row of staging
+        std::vector<float> staging(logits.dataType() == fp32 ? 0 : classes);
+        std::vector<float> scratch(gradient ? 0 : classes);
+        for (auto row = begin; row < end; row++)
+        {
+            const float *x = logits.dataType() == fp32 ? logits.data<float>() + row * classes : staging.data();
+            if (!staging.empty())
+                loadAsFloat(logits, row * classes, classes, staging.data());
+            auto label = static_cast<long long>(labelValues[row - begin]);
+            if (label < 0 || label >= static_cast<long long>(classes))
+                throwException("SoftmaxCrossEntropy: label " + std::to_string(label) + " out of range");
+            auto e = gradient ? gradient->data<float>() + row * classes : scratch.data();
+            auto max = rowMax(x, classes);
+            auto sum = shiftedExp(x, e, classes, max);
+            loss.data<float>()[row] = max + std::log(sum) - x[label];
+            if (gradient)
+            {
+                auto inverse = 1.f / sum;
+                for (std::size_t i = 0; i < classes; i++)
+                    e[i] *= inverse;
+                e[label] -= 1.f;
+            }
+        }
+    };
+    if (pool && batch > 1)
+        pool->parallelFor(0, batch, body, 16);
+    else
+        body(0, batch);
+}
+
+} // kernels
+} // yt
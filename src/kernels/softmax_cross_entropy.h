@@ -0,0 +1,20 @@
+#pragma once
+
+#include <tensor.h>
+
+namespace yt {
+namespace runtime {
+class ThreadPool;
+} // runtime
+
+namespace kernels {
+
+// Per row of logits [N, C]: loss[n] = logsumexp(logits[n]) - logits[n][labels[n]] and, when
+// gradient is given, gradient[n] = softmax(logits[n]) - onehot(labels[n]).
+// Logits may be stored in any floating point type, labels in any integer type; loss and gradient
+// are fp32. Rows are spread over pool when one is given.
+void softmaxCrossEntropy(const Tensor &logits, const Tensor &labels, Tensor &loss, Tensor *gradient,
+                         runtime::ThreadPool *pool = nullptr);
+
+} // kernels
+} // yt
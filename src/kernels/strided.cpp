@@ -0,0 +1,78 @@
+#include "strided.h"
+#include <throw_exception.h>
+#include <cstdint>
+#include <cstring>
+
+namespace yt {
+namespace kernels {
+
+namespace {
+
+// Operand 0 is the destination, operand 1 the source
+template<typename T>
+void copyRows(const StridedLoop<2> &loop, const void *src, void *dst)
+{
+    auto x = static_cast<const T*>(src);
+    auto y = static_cast<T*>(dst);
+    auto length = loop.rowLength();
+    if (loop.unitRows())
+        return loop.forEachRow([x, y, length](const std::array<std::ptrdiff_t, 2> &offsets) {
+            std::memcpy(y + offsets[0], x + offsets[1], length * sizeof(T));
+        });
+    auto dstStride = loop.rowStride(0), srcStride = loop.rowStride(1);
+    loop.forEachRow([x, y, length, dstStride, srcStride](const std::array<std::ptrdiff_t, 2> &offsets) {
+        auto from = x + offsets[1];
+        auto to = y + offsets[0];
+        for (std::size_t i = 0; i < length; i++)
+            to[i * dstStride] = from[i * srcStride];
+    });
+}
+
+} // namespace
+
+void copyStrided(const Tensor &src, Tensor &dst)
+{
+    if (src.empty() || dst.empty() || src.dataType() != dst.dataType() || src.numElements() != dst.numElements())
+        throwException("Strided copy: expected tensors with storage, the same data type and element count");
+    if (src.layout() != Layout::nchw || dst.layout() != Layout::nchw)
+    {
+        if (src.layout() != dst.layout() || src.shape() != dst.shape())
+            throwException("Strided copy: use reorder to change layouts");
+        std::memcpy(dst.data(), src.data(), src.sizeInBytes());
+        return;
+    }
+    if (src.numElements() == 0)
+        return;
+    // Different shapes reinterpret the contiguous side in the other side's shape
+    auto shape = src.shape();
+    auto srcStrides = src.strides();
+    Strides dstStrides;
+    if (dst.shape() == shape)
+        dstStrides = dst.strides();
+    else if (dst.isContiguous())
+        dstStrides = contiguousStrides(shape);
+    else if (src.isContiguous())
+    {
+        shape = dst.shape();
+        srcStrides = contiguousStrides(shape);
+        dstStrides = dst.strides();
+    }
+    else
+        throwException("Strided copy: reshaping needs one contiguous side");
+
+    StridedLoop<2> loop {shape, {dstStrides, srcStrides}};
+    switch (dataTypeSize(src.dataType()))
+    {
+    case 1:
+        return copyRows<std::uint8_t>(loop, src.data(), dst.data());
+    case 2:
+        return copyRows<std::uint16_t>(loop, src.data(), dst.data());
+    case 4:
+        return copyRows<std::uint32_t>(loop, src.data(), dst.data());
+    default:
+        return copyRows<std::uint64_t>(loop, src.data(), dst.data());
+    }
+}
+
+} // kernels
+} // yt
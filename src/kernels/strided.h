@@ -0,0 +1,91 @@
+#pragma once
+
+#include <tensor.h>
+#include <array>
+#include <cstddef>
+
+namespace yt {
+namespace kernels {
+
+// Joint iteration space of N strided operands of the same logical shape. Dimensions of size 1 are
+// dropped and neighbouring dimensions are merged wherever every operand steps through them as one,
+// so a contiguous view becomes a single row and a transposed one the fewest, longest rows possible.
+template<std::size_t N>
+struct StridedLoop
+{
+    Shape shape {};                  // outermost first; at least one dimension
+    std::array<Strides, N> strides {};
+
+    StridedLoop(const Shape &fullShape, const std::array<Strides, N> &fullStrides)
+    {
+        for (std::size_t d = 0; d < fullShape.size(); d++)
+        {
+            if (fullShape[d] == 1)
+                continue;
+            bool merges = !shape.empty();
+            for (std::size_t i = 0; merges && i < N; i++)
+                merges = strides[i].back() == fullStrides[i][d] * static_cast<std::ptrdiff_t>(fullShape[d]);
+            if (merges)
+            {
+                shape.back() *= fullShape[d];
+                for (std::size_t i = 0; i < N; i++)
+                    strides[i].back() = fullStrides[i][d];
+                continue;
+            }
+            shape.push_back(fullShape[d]);
+            for (std::size_t i = 0; i < N; i++)
+                strides[i].push_back(fullStrides[i][d]);
+        }
+        if (shape.empty())
+        {
+            shape.push_back(fullShape.numElements());
+            for (auto &operandStrides : strides)
+                operandStrides.push_back(1);
+        }
+    }
+
+    std::size_t rowLength() const { return shape.back(); }
+    std::ptrdiff_t rowStride(std::size_t operand) const { return strides[operand].back(); }
+    // Every operand walks its row with unit stride
+    bool unitRows() const
+    {
+        for (const auto &operandStrides : strides)
+            if (operandStrides.back() != 1)
+                return false;
+        return true;
+    }
+
+    // Calls row(offsets) for every row, offsets[i] being the element offset of the row in operand i
+    template<typename Row>
+    void forEachRow(Row &&row) const
+    {
+        auto outer = shape.size() - 1;
+        std::array<std::ptrdiff_t, N> offsets {};
+        std::vector<std::size_t> index(outer);
+        std::size_t rows {1};
+        for (std::size_t d = 0; d < outer; d++)
+            rows *= shape[d];
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            row(static_cast<const std::array<std::ptrdiff_t, N>&>(offsets));
+            // Odometer increment over the outer dimensions, innermost first
+            for (auto d = outer; d-- > 0;)
+            {
+                for (std::size_t i = 0; i < N; i++)
+                    offsets[i] += strides[i][d];
+                if (++index[d] < shape[d])
+                    break;
+                for (std::size_t i = 0; i < N; i++)
+                    offsets[i] -= strides[i][d] * static_cast<std::ptrdiff_t>(shape[d]);
+                index[d] = 0;
+            }
+        }
+    }
+};
+
+// Copies src into dst element by element in logical order; both may be strided views.
+// Shapes must have the same number of elements, so a copy also reshapes.
+void copyStrided(const Tensor &src, Tensor &dst);
+
+} // kernels
+} // yt
@@ -0,0 +1,230 @@
+#include "batching_front_end.h"
+#include <kernels/strided.h>
+#include <throw_exception.h>
+#include <cstring>
+#include <exception>
+#include <string>
+
+namespace yt {
+namespace runtime {
+
+using namespace std::string_literals;
+
+namespace {
+
+std::size_t rowsOf(const std::vector<Tensor> &inputs)
+{
+    return inputs.empty() || inputs.front().shape().empty() ? 0 : inputs.front().shape().front();
+}
+
+// Requests can share a run if every input agrees in data type, layout and in all dimensions but the first
+bool compatible(const std::vector<Tensor> &a, const std::vector<Tensor> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); i++)
+    {
+        const auto &shapeA = a[i].shape();
+        const auto &shapeB = b[i].shape();
+        if (a[i].dataType() != b[i].dataType() || a[i].layout() != b[i].layout() || shapeA.size() != shapeB.size() ||
+            !std::equal(shapeA.begin() + 1, shapeA.end(), shapeB.begin() + 1))
+            return false;
+    }
+    return true;
+}
+
+// The batch dimension is outermost in every layout, so rows stay whole byte ranges even when blocked
+std::size_t rowBytes(const Tensor &tensor)
+{
+    auto rows = tensor.shape().front();
+    return rows ? tensor.sizeInBytes() / rows : 0;
+}
+
+BatchingFrontEnd::Options checkOptions(BatchingFrontEnd::Options options)
+{
+    if (!options.maxBatchSize)
+        throwException("Batching front end: maxBatchSize must be positive");
+    return options;
+}
+
+} // namespace
+
+BatchingFrontEnd::BatchingFrontEnd(Executor &executor, Options options) :
+    executor_ {executor},
+    options_ {checkOptions(options)},
+    dispatcher_ {[this]() { dispatchLoop(); }}
+{
+}
+
+BatchingFrontEnd::~BatchingFrontEnd()
+{
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    dispatcher_.join();
+}
+
+std::future<std::vector<Tensor>> BatchingFrontEnd::submit(std::vector<Tensor> inputs)
+{
+    Request request {std::move(inputs), {}, std::chrono::steady_clock::now()};
+    auto future = request.result.get_future();
+    bool valid = !request.inputs.empty();
+    for (const auto &input : request.inputs)
+        valid = valid && !input.empty() && !input.shape().empty() && input.shape().front() == rowsOf(request.inputs);
+    if (!valid)
+    {
+        request.result.set_exception(std::make_exception_ptr(
+                Exception{"Batching front end: every input needs storage and the same leading dimension"}));
+        return future;
+    }
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        if (stopping_)
+            throwException("Batching front end is shutting down");
+        queue_.push_back(std::move(request));
+    }
+    cv_.notify_all();
+    return future;
+}
+
+std::size_t BatchingFrontEnd::batchesRun() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return batchesRun_;
+}
+
+void BatchingFrontEnd::dispatchLoop()
+{
+    std::unique_lock<std::mutex> lock {mutex_};
+    for (;;)
+    {
+        cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            return;
+        auto batch = takeBatch(lock);
+        batchesRun_++;
+        lock.unlock();
+        runBatch(batch);
+        lock.lock();
+    }
+}
+
+std::vector<BatchingFrontEnd::Request> BatchingFrontEnd::takeBatch(std::unique_lock<std::mutex> &lock)
+{
+    auto queuedRows = [this]() {
+        std::size_t rows {};
+        for (const auto &request : queue_)
+            if (compatible(request.inputs, queue_.front().inputs))
+                rows += rowsOf(request.inputs);
+        return rows;
+    };
+    auto deadline = queue_.front().arrival + options_.maxWait;
+    cv_.wait_until(lock, deadline, [&]() { return stopping_ || queuedRows() >= options_.maxBatchSize; });
+
+    std::vector<Request> batch;
+    std::size_t rows {};
+    for (auto it = queue_.begin(); it != queue_.end();)
+    {
+        auto requestRows = rowsOf(it->inputs);
+        bool fits = batch.empty() || (compatible(it->inputs, batch.front().inputs) &&
+                                      rows + requestRows <= options_.maxBatchSize);
+        if (!fits)
+        {
+            ++it;
+            continue;
+        }
+        rows += requestRows;
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+        if (rows >= options_.maxBatchSize)
+            break;
+    }
+    return batch;
+}
+
+void BatchingFrontEnd::runBatch(std::vector<Request> &batch)
+{
+    try
+    {
+        std::vector<Tensor> inputs;
+        if (batch.size() == 1)
+            inputs = batch.front().inputs;
+        else
+        {
+            std::size_t totalRows {};
+            for (const auto &request : batch)
+                totalRows += rowsOf(request.inputs);
+            for (std::size_t i = 0; i < batch.front().inputs.size(); i++)
+            {
+                const auto &prototype = batch.front().inputs[i];
+                auto shape = prototype.shape();
+                shape.front() = totalRows;
+                Tensor stacked {prototype.dataType(), shape, prototype.layout()};
+                std::size_t firstRow {};
+                for (const auto &request : batch)
+                {
+                    const auto &input = request.inputs[i];
+                    if (input.isContiguous())
+                        std::memcpy(static_cast<char*>(stacked.data()) + firstRow * rowBytes(stacked), input.data(),
+                                    input.sizeInBytes());
+                    else
+                    {
+                        // Strided views are nchw, so their rows are a plain sub-range of the stacked tensor
+                        auto rows = stacked.view(input.shape(), contiguousStrides(input.shape()),
+                                                 firstRow * (stacked.numElements() / totalRows));
+                        kernels::copyStrided(input, rows);
+                    }
+                    firstRow += rowsOf(request.inputs);
+                }
+                inputs.push_back(std::move(stacked));
+            }
+        }
+        auto totalRows = rowsOf(inputs);
+        auto outputs = executor_.run(inputs);
+        if (batch.size() == 1)
+        {
+            batch.front().result.set_value(std::move(outputs));
+            return;
+        }
+        for (const auto &output : outputs)
+            if (output.shape().empty() || output.shape().front() != totalRows)
+                throwException("Batching front end: output leading dimension "s +
+                               "doesn't match the batch, cannot scatter results"s);
+        std::size_t firstRow {};
+        for (auto &request : batch)
+        {
+            auto rows = rowsOf(request.inputs);
+            std::vector<Tensor> results;
+            for (const auto &output : outputs)
+            {
+                auto shape = output.shape();
+                shape.front() = rows;
+                Tensor slice {output.dataType(), shape, output.layout()};
+                std::memcpy(slice.data(), static_cast<const char*>(output.data()) + firstRow * rowBytes(output),
+                            slice.sizeInBytes());
+                results.push_back(std::move(slice));
+            }
+            request.result.set_value(std::move(results));
+            firstRow += rows;
+        }
+    }
+    catch (...)
+    {
+        auto error = std::current_exception();
+        for (auto &request : batch)
+        {
+            try
+            {
+                request.result.set_exception(error);
+            }
+            catch (const std::future_error &)
+            {
+            }
+        }
+    }
+}
+
+} // runtime
+} // yt
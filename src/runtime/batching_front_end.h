@@ -0,0 +1,62 @@
+#pragma once
+
+#include "executor.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Thread-safe submission queue in front of an Executor whose graph inputs have a dynamic leading
+// (batch) dimension. Requests are coalesced along that dimension into one run, up to
+// maxBatchSize rows or until the oldest request has waited maxWait, and every request gets its
+// own rows of each output back through its future.
+class BatchingFrontEnd
+{
+public:
+    struct Options
+    {
+        std::size_t maxBatchSize {32};
+        std::chrono::microseconds maxWait {1000};
+    };
+
+    // The executor must outlive the front end
+    BatchingFrontEnd(Executor &executor, Options options);
+    ~BatchingFrontEnd();
+    BatchingFrontEnd(const BatchingFrontEnd &) = delete;
+    BatchingFrontEnd &operator=(const BatchingFrontEnd &) = delete;
+
+    // One tensor per graph input; all of them share the same leading dimension (usually 1)
+    std::future<std::vector<Tensor>> submit(std::vector<Tensor> inputs);
+    std::size_t batchesRun() const;
+
+private:
+    struct Request
+    {
+        std::vector<Tensor> inputs;
+        std::promise<std::vector<Tensor>> result;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    void dispatchLoop();
+    std::vector<Request> takeBatch(std::unique_lock<std::mutex> &lock);
+    void runBatch(std::vector<Request> &batch);
+
+    Executor &executor_;
+    Options options_;
+    std::deque<Request> queue_ {};
+    std::size_t batchesRun_ {};
+    bool stopping_ {false};
+    mutable std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    std::thread dispatcher_;
+};
+
+} // runtime
+} // yt
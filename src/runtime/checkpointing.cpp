@@ -0,0 +1,268 @@
+#include "checkpointing.h"
+#include <kernels/strided.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+namespace yt {
+namespace runtime {
+
+using namespace std::string_literals;
+
+namespace {
+
+std::vector<std::size_t> userBoundaries(const ExecutionPlan &plan, const std::vector<const graph::Node*> &checkpoints)
+{
+    std::unordered_map<const graph::Node*, std::size_t> stepOf;
+    for (std::size_t i = 0; i < plan.steps.size(); i++)
+        stepOf[plan.steps[i].node] = i;
+    std::vector<std::size_t> boundaries;
+    for (auto node : checkpoints)
+    {
+        auto step = stepOf.find(node);
+        if (step == stepOf.end())
+            throwException("Checkpointing failure: "s + (node ? node->name() : "null"s) +
+                           " is not a step of the plan"s);
+        boundaries.push_back(step->second + 1);
+    }
+    return boundaries;
+}
+
+// Greedily closes a segment once it holds about 1/sqrt(N) of the activation bytes
+std::vector<std::size_t> sqrtBoundaries(const ExecutionPlan &plan)
+{
+    std::vector<std::size_t> stepBytes(plan.steps.size());
+    std::size_t totalBytes {};
+    for (std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        if (plan.steps[i].inputs.empty())
+            continue;
+        for (auto slot : plan.steps[i].outputs)
+            stepBytes[i] += plan.slots[slot].size;
+        totalBytes += stepBytes[i];
+    }
+    auto numComputeSteps = std::count_if(plan.steps.begin(), plan.steps.end(),
+                                         [](const ExecutionStep &step) { return !step.inputs.empty(); });
+    auto numSegments = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(numComputeSteps))));
+    auto target = numSegments ? (totalBytes + numSegments - 1) / numSegments : totalBytes;
+    std::vector<std::size_t> boundaries;
+    std::size_t accumulated {};
+    for (std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        accumulated += stepBytes[i];
+        if (accumulated >= target)
+        {
+            boundaries.push_back(i + 1);
+            accumulated = 0;
+        }
+    }
+    return boundaries;
+}
+
+// Graph inputs, constants and the outputs of source steps are parameters of the pass rather than
+// activations: they are kept anyway and don't count towards activation memory. Views own no memory;
+// the contiguous copies made of them are activations of the step that reads them.
+std::vector<bool> findActivations(const ExecutionPlan &plan)
+{
+    std::vector<bool> activations(plan.slots.size());
+    for (const auto &step : plan.steps)
+        if (!step.inputs.empty())
+        {
+            for (auto slot : step.outputs)
+                activations[slot] = true;
+            for (const auto &materialization : step.materializations)
+                activations[materialization.slot] = true;
+        }
+    return activations;
+}
+
+} // namespace
+
+std::size_t CheckpointPlan::numSegments() const
+{
+    return segmentStarts.size();
+}
+
+std::pair<std::size_t, std::size_t> CheckpointPlan::segmentSteps(std::size_t segment, const ExecutionPlan &plan) const
+{
+    if (segment >= segmentStarts.size())
+        throwException("Checkpointing failure: segment "s + std::to_string(segment) + " is out of range"s);
+    auto end = segment + 1 < segmentStarts.size() ? segmentStarts[segment + 1] : plan.steps.size();
+    return {segmentStarts[segment], end};
+}
+
+CheckpointPlan planCheckpoints(const ExecutionPlan &plan, const std::vector<const graph::Node*> &checkpoints)
+{
+    auto boundaries = checkpoints.empty() ? sqrtBoundaries(plan) : userBoundaries(plan, checkpoints);
+    std::sort(boundaries.begin(), boundaries.end());
+    CheckpointPlan result;
+    result.segmentStarts.push_back(0);
+    for (auto boundary : boundaries)
+        if (boundary > result.segmentStarts.back() && boundary < plan.steps.size())
+            result.segmentStarts.push_back(boundary);
+
+    auto segmentOf = [&result](std::size_t step) {
+        return std::upper_bound(result.segmentStarts.begin(), result.segmentStarts.end(), step) -
+               result.segmentStarts.begin() - 1;
+    };
+    // Results outlive the pass, activations read across a boundary are the checkpoints
+    auto activations = findActivations(plan);
+    result.stored.resize(plan.slots.size());
+    for (std::size_t i = 0; i < plan.slots.size(); i++)
+    {
+        const auto &slot = plan.slots[i];
+        result.stored[i] = !activations[i] || slot.lastStep >= plan.steps.size() ||
+                           segmentOf(slot.firstStep) != segmentOf(slot.lastStep);
+        if (activations[i])
+        {
+            result.peakBytesWithoutCheckpointing += slot.size;
+            if (result.stored[i])
+                result.storedBytes += slot.size;
+        }
+    }
+
+    // Forward pass: stored tensors accumulate, the others are freed after their last reader
+    std::size_t live {};
+    std::size_t peak {};
+    for (std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        for (auto slot : plan.steps[i].outputs)
+            if (activations[slot])
+                live += plan.slots[slot].size;
+        for (const auto &materialization : plan.steps[i].materializations)
+            live += plan.slots[materialization.slot].size;
+        peak = std::max(peak, live);
+        for (const auto *slots : {&plan.steps[i].inputs, &plan.steps[i].outputs})
+            for (auto slot : *slots)
+                if (!result.stored[slot] && plan.slots[slot].lastStep == i)
+                    live -= plan.slots[slot].size;
+    }
+    // Backward pass over segment k: stored tensors produced up to its end plus its recomputed activations
+    for (std::size_t segment = result.numSegments(); segment-- > 0;)
+    {
+        auto steps = result.segmentSteps(segment, plan);
+        std::size_t bytes {};
+        for (std::size_t i = 0; i < plan.slots.size(); i++)
+        {
+            const auto &slot = plan.slots[i];
+            if (!activations[i])
+                continue;
+            bool storedSoFar = result.stored[i] && slot.firstStep < steps.second;
+            bool recomputed = !result.stored[i] && slot.firstStep >= steps.first && slot.firstStep < steps.second;
+            if (storedSoFar || recomputed)
+                bytes += slot.size;
+        }
+        peak = std::max(peak, bytes);
+    }
+    result.peakBytesWithCheckpointing = peak;
+    return result;
+}
+
+CheckpointedRun::CheckpointedRun(std::shared_ptr<const ExecutionPlan> plan, CheckpointPlan checkpoints,
+                                 const std::vector<Tensor> &inputs) :
+    plan_ {std::move(plan)},
+    checkpoints_ {std::move(checkpoints)}
+{
+    if (checkpoints_.stored.size() != plan_->slots.size())
+        throwException("Checkpointing failure: checkpoint plan was made for a different execution plan");
+    std::vector<Tensor> tensors(plan_->slots.size());
+    for (std::size_t i = 0; i < plan_->slots.size(); i++)
+    {
+        const auto &slot = plan_->slots[i];
+        if (slot.constant)
+            tensors[i] = *slot.constant;
+        if (slot.inputIndex < 0)
+            continue;
+        if (static_cast<std::size_t>(slot.inputIndex) >= inputs.size())
+            throwException("Checkpointing failure: input #"s + std::to_string(slot.inputIndex) + " is missing"s);
+        const auto &input = inputs[slot.inputIndex];
+        if (input.dataType() != slot.dtype || input.layout() != slot.layout || input.empty())
+            throwException("Checkpointing failure: input #"s + std::to_string(slot.inputIndex) +
+                           " has wrong data type or no storage"s);
+        tensors[i] = input.contiguous();
+    }
+    runSteps(0, plan_->steps.size(), tensors, false);
+    stored_ = std::move(tensors);
+}
+
+const CheckpointPlan &CheckpointedRun::checkpoints() const
+{
+    return checkpoints_;
+}
+
+std::vector<Tensor> CheckpointedRun::results() const
+{
+    std::vector<Tensor> results;
+    results.reserve(plan_->resultSlots.size());
+    for (auto slot : plan_->resultSlots)
+    {
+        const auto &slotInfo = plan_->slots[slot];
+        results.push_back(slotInfo.viewOf >= 0 ? bindView(slotInfo, stored_[slotInfo.viewOf]) : stored_[slot]);
+    }
+    return results;
+}
+
+std::vector<Tensor> CheckpointedRun::recomputeSegment(std::size_t segment) const
+{
+    auto steps = checkpoints_.segmentSteps(segment, *plan_);
+    auto tensors = stored_;
+    runSteps(steps.first, steps.second, tensors, true);
+    return tensors;
+}
+
+void CheckpointedRun::runSteps(std::size_t first, std::size_t last, std::vector<Tensor> &tensors, bool keepAll) const
+{
+    std::vector<const Tensor*> stepInputs;
+    std::vector<Tensor*> stepOutputs;
+    for (auto i = first; i < last; i++)
+    {
+        const auto &step = plan_->steps[i];
+        // While recomputing, steps whose outputs were all stored are skipped; the others get fresh
+        // tensors so that stored tensors shared with callers are never written again
+        auto present = [&tensors](std::size_t slot) { return !tensors[slot].empty(); };
+        if (std::all_of(step.outputs.begin(), step.outputs.end(), present))
+            continue;
+        stepInputs.clear();
+        stepOutputs.clear();
+        // Views are bound to the current tensor of the storage they alias just for this step, so they
+        // never keep a freed activation alive
+        auto bindViews = [this, &tensors](std::size_t slot) {
+            const auto &slotInfo = plan_->slots[slot];
+            if (slotInfo.viewOf >= 0)
+                tensors[slot] = bindView(slotInfo, tensors[slotInfo.viewOf]);
+        };
+        for (auto slot : step.inputs)
+            bindViews(slot);
+        for (const auto &materialization : step.materializations)
+        {
+            bindViews(materialization.view);
+            const auto &slotInfo = plan_->slots[materialization.slot];
+            tensors[materialization.slot] = Tensor {slotInfo.dtype, slotInfo.shape};
+            kernels::copyStrided(tensors[materialization.view], tensors[materialization.slot]);
+            tensors[materialization.view] = Tensor {};
+        }
+        for (auto slot : step.inputs)
+            stepInputs.push_back(&tensors[slot]);
+        for (auto slot : step.outputs)
+        {
+            const auto &slotInfo = plan_->slots[slot];
+            tensors[slot] = Tensor {slotInfo.dtype, slotInfo.shape, slotInfo.layout};
+            stepOutputs.push_back(&tensors[slot]);
+        }
+        step.kernel(stepInputs, stepOutputs);
+        for (auto slot : step.inputs)
+            if (plan_->slots[slot].viewOf >= 0)
+                tensors[slot] = Tensor {};
+        if (keepAll)
+            continue;
+        for (const auto *slots : {&step.inputs, &step.outputs})
+            for (auto slot : *slots)
+                if (!checkpoints_.stored[slot] && plan_->slots[slot].lastStep == i)
+                    tensors[slot] = Tensor {};
+    }
+}
+
+} // runtime
+} // yt
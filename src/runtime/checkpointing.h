@@ -0,0 +1,59 @@
+#pragma once
+
+#include "execution_plan.h"
+#include <tensor.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Splits the steps of a forward plan into segments for activation recomputation.
+// Only tensors that cross a segment boundary (and the graph results) are kept after the forward
+// pass; the backward pass walks the segments in reverse and re-runs each one from those stored
+// tensors. Boundaries follow user-marked nodes, or the sqrt(N) heuristic when none are given.
+// Graph inputs and constant outputs are parameters: always kept and not counted as activations.
+struct CheckpointPlan
+{
+    // Step indices where segments begin; the first is always 0
+    std::vector<std::size_t> segmentStarts {};
+    // Per plan slot: kept from the forward pass until the backward pass is done with it
+    std::vector<bool> stored {};
+    std::size_t storedBytes {};
+    // Activation memory of a training step: every activation held until backward vs. checkpointed
+    std::size_t peakBytesWithoutCheckpointing {};
+    std::size_t peakBytesWithCheckpointing {};
+
+    std::size_t numSegments() const;
+    // Half-open step range [first, second) of a segment
+    std::pair<std::size_t, std::size_t> segmentSteps(std::size_t segment, const ExecutionPlan &plan) const;
+};
+
+// A segment boundary is placed right after each checkpoint node; with no checkpoints the steps are
+// grouped into about sqrt(N) segments holding similar amounts of activation memory
+CheckpointPlan planCheckpoints(const ExecutionPlan &plan, const std::vector<const graph::Node*> &checkpoints = {});
+
+// Forward pass that keeps only the stored tensors of a CheckpointPlan and recomputes the rest on demand
+class CheckpointedRun
+{
+public:
+    CheckpointedRun(std::shared_ptr<const ExecutionPlan> plan, CheckpointPlan checkpoints,
+                    const std::vector<Tensor> &inputs);
+
+    const CheckpointPlan &checkpoints() const;
+    std::vector<Tensor> results() const;
+    // Re-runs the segment from the stored tensors. The result is indexed by plan slot and holds the
+    // stored tensors plus every tensor produced inside the segment; other slots are empty.
+    std::vector<Tensor> recomputeSegment(std::size_t segment) const;
+
+private:
+    void runSteps(std::size_t first, std::size_t last, std::vector<Tensor> &tensors, bool keepAll) const;
+
+    std::shared_ptr<const ExecutionPlan> plan_;
+    CheckpointPlan checkpoints_;
+    std::vector<Tensor> stored_ {};
+};
+
+} // runtime
+} // yt
@@ -0,0 +1,207 @@
+#include "cost_model.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YT_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace yt {
+namespace runtime {
+
+namespace {
+
+constexpr std::size_t kFmaIterations = std::size_t {1} << 20;
+// Three 16 MiB arrays, well past the last-level cache of the machines we run on
+constexpr std::size_t kTriadElements = std::size_t {1} << 22;
+constexpr int kRepetitions = 3;
+
+volatile float benchmarkSink;
+
+// Independent accumulators hide the FMA latency; returns the number of FLOPs executed
+double fmaLoopScalar()
+{
+    float acc[8] {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f};
+    const float scale = 0.999999f, offset = 1e-7f;
+    for (std::size_t i = 0; i < kFmaIterations; i++)
+        for (auto &value : acc)
+            value = value * scale + offset;
+    float sum {};
+    for (auto value : acc)
+        sum += value;
+    benchmarkSink = sum;
+    return 2. * 8 * kFmaIterations;
+}
+
+#ifdef YT_HAS_X86_DISPATCH
+
+[[gnu::target("avx2,fma")]] double fmaLoopAvx2()
+{
+    constexpr int kAccumulators = 10;
+    __m256 acc[kAccumulators];
+    for (int j = 0; j < kAccumulators; j++)
+        acc[j] = _mm256_set1_ps(static_cast<float>(j + 1));
+    const auto scale = _mm256_set1_ps(0.999999f);
+    const auto offset = _mm256_set1_ps(1e-7f);
+    for (std::size_t i = 0; i < kFmaIterations; i++)
+        for (int j = 0; j < kAccumulators; j++)
+            acc[j] = _mm256_fmadd_ps(acc[j], scale, offset);
+    auto sum = acc[0];
+    for (int j = 1; j < kAccumulators; j++)
+        sum = _mm256_add_ps(sum, acc[j]);
+    benchmarkSink = _mm_cvtss_f32(_mm256_castps256_ps128(sum));
+    return 2. * 8 * kAccumulators * kFmaIterations;
+}
+
+bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#endif
+
+double fmaLoop()
+{
+#ifdef YT_HAS_X86_DISPATCH
+    if (hasAvx2())
+        return fmaLoopAvx2();
+#endif
+    return fmaLoopScalar();
+}
+
+template<typename Function>
+double bestRate(Function &&function)
+{
+    double best {};
+    for (int i = 0; i < kRepetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto amount = function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, amount / std::max(elapsed.count(), 1e-9));
+    }
+    return best;
+}
+
+double slotBytes(const TensorSlot &slot)
+{
+    return static_cast<double>(storageElements(slot.shape, slot.layout) * dataTypeSize(slot.dtype));
+}
+
+} // namespace
+
+double MachinePeaks::ridgePoint() const
+{
+    return bytesPerSecond > 0. ? flopsPerSecond / bytesPerSecond : std::numeric_limits<double>::infinity();
+}
+
+MachinePeaks measureMachinePeaks()
+{
+    MachinePeaks peaks;
+    peaks.flopsPerSecond = bestRate(fmaLoop);
+
+    std::vector<float> a(kTriadElements), b(kTriadElements, 1.f), c(kTriadElements, 2.f);
+    peaks.bytesPerSecond = bestRate([&a, &b, &c]() {
+        const float scale = 3.f;
+        for (std::size_t i = 0; i < kTriadElements; i++)
+            a[i] = b[i] + scale * c[i];
+        benchmarkSink = a[kTriadElements / 2];
+        return 3. * sizeof(float) * kTriadElements;
+    });
+    return peaks;
+}
+
+CostReport analyzeCost(const ExecutionPlan &plan, const MachinePeaks &peaks)
+{
+    CostReport report;
+    report.peaks = peaks;
+    auto ridge = peaks.ridgePoint();
+    std::vector<std::ptrdiff_t> producerOf(plan.slots.size(), -1);
+    // Views and their contiguous copies depend on whoever wrote the storage they alias
+    std::vector<std::size_t> storageOf(plan.slots.size());
+    for (std::size_t i = 0; i < plan.slots.size(); i++)
+        storageOf[i] = plan.slots[i].viewOf >= 0 ? plan.slots[i].viewOf : i;
+    for (const auto &step : plan.steps)
+        for (const auto &materialization : step.materializations)
+            storageOf[materialization.slot] = storageOf[materialization.view];
+    std::vector<double> finish(plan.steps.size());
+    std::vector<std::ptrdiff_t> previous(plan.steps.size(), -1);
+    std::vector<Shape> shapes;
+    for (std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        const auto &step = plan.steps[i];
+        NodeCost cost;
+        cost.node = step.node;
+        shapes.clear();
+        double start {};
+        for (auto slot : step.inputs)
+        {
+            shapes.push_back(plan.slots[slot].shape);
+            cost.bytes += slotBytes(plan.slots[slot]);
+            auto producer = producerOf[storageOf[slot]];
+            if (producer >= 0 && finish[producer] > start)
+            {
+                start = finish[producer];
+                previous[i] = producer;
+            }
+        }
+        // Materializing reads the view and writes the copy the kernel then reads again
+        for (const auto &materialization : step.materializations)
+            cost.bytes += 2. * slotBytes(plan.slots[materialization.slot]);
+        for (auto slot : step.outputs)
+        {
+            cost.bytes += slotBytes(plan.slots[slot]);
+            producerOf[slot] = static_cast<std::ptrdiff_t>(i);
+        }
+        cost.flops = step.node->flops(shapes);
+        cost.arithmeticIntensity = cost.bytes > 0. ? cost.flops / cost.bytes : 0.;
+        cost.bound = cost.arithmeticIntensity >= ridge ? Bound::compute : Bound::memory;
+        cost.seconds = std::max(peaks.flopsPerSecond > 0. ? cost.flops / peaks.flopsPerSecond : 0.,
+                                peaks.bytesPerSecond > 0. ? cost.bytes / peaks.bytesPerSecond : 0.);
+        finish[i] = start + cost.seconds;
+
+        report.totalFlops += cost.flops;
+        report.totalBytes += cost.bytes;
+        report.serialSeconds += cost.seconds;
+        report.nodes.push_back(cost);
+    }
+
+    if (!finish.empty())
+    {
+        auto last = std::max_element(finish.begin(), finish.end()) - finish.begin();
+        report.criticalPathSeconds = finish[last];
+        for (auto step = last; step >= 0; step = previous[step])
+            report.nodes[step].onCriticalPath = true;
+    }
+    return report;
+}
+
+std::ostream &operator<<(std::ostream &stream, const CostReport &report)
+{
+    auto flags = stream.flags();
+    auto precision = stream.precision();
+    stream << std::setprecision(3)
+           << "peak " << report.peaks.flopsPerSecond * 1e-9 << " GFLOP/s, " << report.peaks.bytesPerSecond * 1e-9
+           << " GB/s, ridge " << report.peaks.ridgePoint() << " FLOP/byte\n"
+           << std::left << std::setw(24) << "node" << std::right << std::setw(12) << "MFLOP" << std::setw(12) << "MB"
+           << std::setw(12) << "FLOP/byte" << std::setw(12) << "est. us" << "  bound\n";
+    for (const auto &node : report.nodes)
+        stream << std::left << std::setw(24) << node.node->name() << std::right
+               << std::setw(12) << node.flops * 1e-6 << std::setw(12) << node.bytes * 1e-6
+               << std::setw(12) << node.arithmeticIntensity << std::setw(12) << node.seconds * 1e6
+               << "  " << (node.bound == Bound::compute ? "compute" : "memory")
+               << (node.onCriticalPath ? " *" : "") << '\n';
+    stream << "total " << report.totalFlops * 1e-6 << " MFLOP, " << report.totalBytes * 1e-6 << " MB, serial "
+           << report.serialSeconds * 1e6 << " us, critical path (*) " << report.criticalPathSeconds * 1e6 << " us\n";
+    stream.flags(flags);
+    stream.precision(precision);
+    return stream;
+}
+
+} // runtime
+} // yt
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "execution_plan.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Single-core peaks the roofline is drawn against
+struct MachinePeaks
+{
+    double flopsPerSecond {};
+    double bytesPerSecond {};
+
+    // Arithmetic intensity (FLOP/byte) above which a kernel is compute-bound
+    double ridgePoint() const;
+};
+
+// Runs an FMA throughput loop and a streaming triad over buffers larger than the last-level cache
+MachinePeaks measureMachinePeaks();
+
+enum class Bound
+{
+    memory,
+    compute
+};
+
+struct NodeCost
+{
+    const graph::Node *node {};
+    double flops {};
+    // Bytes of all inputs read plus all outputs written
+    double bytes {};
+    double arithmeticIntensity {};
+    // Roofline lower bound: max(flops / peak FLOP rate, bytes / peak bandwidth)
+    double seconds {};
+    Bound bound {Bound::memory};
+    bool onCriticalPath {};
+};
+
+struct CostReport
+{
+    MachinePeaks peaks {};
+    // One entry per plan step, in execution order
+    std::vector<NodeCost> nodes {};
+    double totalFlops {};
+    double totalBytes {};
+    // Sum of all node estimates, i.e. the time on one core
+    double serialSeconds {};
+    // Longest dependency chain, i.e. the time with unlimited cores running independent nodes in parallel
+    double criticalPathSeconds {};
+};
+
+CostReport analyzeCost(const ExecutionPlan &plan, const MachinePeaks &peaks);
+
+std::ostream &operator<<(std::ostream &stream, const CostReport &report);
+
+} // runtime
+} // yt
@@ -0,0 +1,77 @@
+#include "data_parallel.h"
+#include <throw_exception.h>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace yt {
+namespace runtime {
+
+void runDataParallel(std::size_t numWorkers, std::size_t datasetSize, std::size_t maxGradientElements,
+                     const DataParallelWorker &worker)
+{
+    ShmAllreduce allreduce {numWorkers, maxGradientElements};
+    std::vector<pid_t> children;
+    for (std::size_t rank = 0; rank < numWorkers; rank++)
+    {
+        auto pid = ::fork();
+        if (pid == 0)
+        {
+            int status = EXIT_SUCCESS;
+            try
+            {
+                worker(rank, shardOf(rank, numWorkers, datasetSize), allreduce);
+            }
+            catch (...)
+            {
+                allreduce.abort();
+                status = EXIT_FAILURE;
+            }
+            // Skip atexit handlers and static destructors that belong to the parent
+            ::_exit(status);
+        }
+        if (pid < 0)
+        {
+            allreduce.abort();
+            for (auto child : children)
+                ::waitpid(child, nullptr, 0);
+            throwException("runDataParallel: fork failed for rank " + std::to_string(rank));
+        }
+        children.push_back(pid);
+    }
+
+    // Poll only our own children: a worker killed by a signal never reaches its abort() call, so
+    // the parent aborts the collectives on its behalf
+    std::string failedRanks;
+    std::vector<bool> exited(children.size(), false);
+    for (std::size_t remaining = children.size(); remaining > 0;)
+    {
+        bool progress {false};
+        for (std::size_t rank = 0; rank < children.size(); rank++)
+        {
+            int status {};
+            if (exited[rank] || ::waitpid(children[rank], &status, WNOHANG) != children[rank])
+                continue;
+            exited[rank] = true;
+            remaining--;
+            progress = true;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+            {
+                allreduce.abort();
+                failedRanks += " " + std::to_string(rank);
+            }
+        }
+        if (!progress)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!failedRanks.empty())
+        throwException("runDataParallel: workers failed:" + failedRanks);
+}
+
+} // runtime
+} // yt
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "shm_allreduce.h"
+#include <cstddef>
+#include <functional>
+
+namespace yt {
+namespace runtime {
+
+using DataParallelWorker = std::function<void(std::size_t rank, ShardRange shard, ShmAllreduce &allreduce)>;
+
+// Forks numWorkers processes on this host. Worker rank r trains on shardOf(r, numWorkers, datasetSize)
+// and synchronizes gradients (up to maxGradientElements floats per call) through allreduce.
+// Workers must open their own dataset streams: file offsets are shared with the parent across fork.
+// Blocks until every worker has exited and throws if any of them failed.
+void runDataParallel(std::size_t numWorkers, std::size_t datasetSize, std::size_t maxGradientElements,
+                     const DataParallelWorker &worker);
+
+} // runtime
+} // yt
@@ -0,0 +1,212 @@
+#include "execution_plan.h"
+#include <graph/constant.h>
+#include <throw_exception.h>
+#include <tensor.h>
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace yt {
+namespace runtime {
+
+using namespace std::string_literals;
+
+namespace {
+
+void checkInputShape(const graph::Node &input, const Shape &shape)
+{
+    const auto &declared = input.outputs().front()->shape();
+    bool matches = declared.size() == shape.size();
+    for (std::size_t i = 0; matches && i < shape.size(); i++)
+        matches = declared[i] == kDynamicDim || declared[i] == shape[i];
+    if (!matches)
+        throwException("Shape of input "s + input.name() + " doesn't match its declaration"s);
+}
+
+std::size_t arenaBytes(const TensorSlot &slot)
+{
+    auto bytes = storageElements(slot.shape, slot.layout) * dataTypeSize(slot.dtype);
+    return (bytes + Tensor::kAlignment - 1) / Tensor::kAlignment * Tensor::kAlignment;
+}
+
+void assignArenaOffsets(ExecutionPlan &plan)
+{
+    std::vector<std::size_t> bySize;
+    for (std::size_t i = 0; i < plan.slots.size(); i++)
+        if (plan.slots[i].inputIndex < 0 && plan.slots[i].viewOf < 0 && !plan.slots[i].constant)
+            bySize.push_back(i);
+    std::stable_sort(bySize.begin(), bySize.end(), [&plan](std::size_t a, std::size_t b) {
+        return plan.slots[a].size > plan.slots[b].size;
+    });
+    std::vector<std::size_t> placed;
+    for (auto index : bySize)
+    {
+        auto &slot = plan.slots[index];
+        std::vector<const TensorSlot*> conflicts;
+        for (auto other : placed)
+        {
+            const auto &otherSlot = plan.slots[other];
+            if (otherSlot.firstStep <= slot.lastStep && slot.firstStep <= otherSlot.lastStep)
+                conflicts.push_back(&otherSlot);
+        }
+        std::sort(conflicts.begin(), conflicts.end(), [](auto a, auto b) { return a->offset < b->offset; });
+        std::size_t offset {};
+        for (auto conflict : conflicts)
+        {
+            if (offset + slot.size <= conflict->offset)
+                break;
+            offset = std::max(offset, conflict->offset + conflict->size);
+        }
+        slot.offset = offset;
+        plan.arenaSize = std::max(plan.arenaSize, offset + slot.size);
+        placed.push_back(index);
+    }
+}
+
+} // namespace
+
+ExecutionPlan compileExecutionPlan(const graph::Nodes &inputs, const graph::Nodes &outputs,
+                                   const std::vector<Shape> &inputShapes)
+{
+    if (inputShapes.size() != inputs.size())
+        throwException("Execution plan failure: expected "s + std::to_string(inputs.size()) + " input shapes"s);
+    ExecutionPlan plan;
+    plan.inputShapes = inputShapes;
+    plan.order = graph::traverseInTopologicalOrder(inputs, outputs);
+
+    std::unordered_map<const graph::TensorDescriptor*, std::size_t> slotOf;
+    std::unordered_map<const graph::Node*, int> inputIndexOf;
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        checkInputShape(*inputs[i], inputShapes[i]);
+        inputIndexOf[inputs[i].get()] = static_cast<int>(i);
+    }
+    // Reading a view keeps the storage it aliases alive as well
+    auto markRead = [&plan](std::size_t slot, std::size_t step) {
+        plan.slots[slot].lastStep = std::max(plan.slots[slot].lastStep, step);
+        auto base = plan.slots[slot].viewOf;
+        if (base >= 0)
+            plan.slots[base].lastStep = std::max(plan.slots[base].lastStep, step);
+    };
+
+    for (auto &node : plan.order)
+    {
+        auto boundInput = inputIndexOf.find(node.get());
+        if (boundInput != inputIndexOf.end())
+        {
+            const auto &descriptor = node->outputs().front();
+            TensorSlot slot {descriptor.get(), descriptor->dataType(), inputShapes[boundInput->second],
+                             descriptor->layout()};
+            slot.inputIndex = boundInput->second;
+            slot.strides = contiguousStrides(slot.shape);
+            slotOf[descriptor.get()] = plan.slots.size();
+            plan.slots.push_back(std::move(slot));
+            continue;
+        }
+        if (auto constant = dynamic_cast<const graph::Constant*>(node.get()))
+        {
+            const auto &descriptor = node->outputs().front();
+            const auto &value = constant->value();
+            TensorSlot slot {descriptor.get(), value.dataType(), value.shape(), value.layout()};
+            slot.constant = &value;
+            slot.strides = contiguousStrides(slot.shape);
+            slotOf[descriptor.get()] = plan.slots.size();
+            plan.slots.push_back(std::move(slot));
+            continue;
+        }
+        ExecutionStep step {node.get()};
+        std::vector<std::size_t> inputSlots;
+        std::vector<Shape> shapes;
+        const auto &nodeInputs = node->inputs();
+        for (std::size_t i = 0; i < nodeInputs.size(); i++)
+        {
+            auto input = nodeInputs[i].lock();
+            if (!input)
+                throwException("Execution plan failure: Input #"s + std::to_string(i) + " of "s + node->name() +
+                               " is not available"s);
+            inputSlots.push_back(slotOf.at(input.get()));
+            shapes.push_back(plan.slots[inputSlots.back()].shape);
+        }
+        if (node->outputs().empty())
+        {
+            for (auto slot : inputSlots)
+                markRead(slot, plan.steps.size());
+            continue;
+        }
+        auto outputShapes = node->inferOutputShapes(shapes);
+        if (outputShapes.size() != node->outputs().size())
+            throwException("Execution plan failure: "s + node->name() + " inferred wrong number of output shapes"s);
+
+        if (node->outputs().front()->isView())
+        {
+            const auto &source = plan.slots[inputSlots.front()];
+            std::optional<graph::ViewGeometry> view;
+            if (source.layout == Layout::nchw)
+                view = node->outputView({source.shape, source.strides, source.elementOffset});
+            if (view)
+            {
+                const auto &descriptor = node->outputs().front();
+                TensorSlot slot {descriptor.get(), descriptor->dataType(), std::move(view->shape), Layout::nchw};
+                slot.viewOf = source.viewOf >= 0 ? source.viewOf : static_cast<std::ptrdiff_t>(inputSlots.front());
+                slot.strides = std::move(view->strides);
+                slot.elementOffset = view->offset;
+                slot.firstStep = slot.lastStep = plan.steps.size();
+                slotOf[descriptor.get()] = plan.slots.size();
+                plan.slots.push_back(std::move(slot));
+                continue;
+            }
+        }
+
+        step.kernel = node->kernel(shapes);
+        if (!step.kernel)
+            throwException("Execution plan failure: "s + node->name() + " has no kernel"s);
+        for (auto slot : inputSlots)
+        {
+            markRead(slot, plan.steps.size());
+            const auto &source = plan.slots[slot];
+            if (source.viewOf < 0 || node->acceptsStridedInputs() || isContiguous(source.shape, source.strides))
+            {
+                step.inputs.push_back(slot);
+                continue;
+            }
+            TensorSlot scratch {source.descriptor, source.dtype, source.shape, Layout::nchw};
+            scratch.strides = contiguousStrides(scratch.shape);
+            scratch.size = arenaBytes(scratch);
+            scratch.firstStep = scratch.lastStep = plan.steps.size();
+            step.materializations.push_back({slot, plan.slots.size()});
+            step.inputs.push_back(plan.slots.size());
+            plan.slots.push_back(std::move(scratch));
+        }
+        for (std::size_t i = 0; i < outputShapes.size(); i++)
+        {
+            const auto &descriptor = node->outputs()[i];
+            TensorSlot slot {descriptor.get(), descriptor->dataType(), outputShapes[i], descriptor->layout()};
+            slot.strides = contiguousStrides(slot.shape);
+            slot.size = arenaBytes(slot);
+            slot.firstStep = slot.lastStep = plan.steps.size();
+            slotOf[descriptor.get()] = plan.slots.size();
+            step.outputs.push_back(plan.slots.size());
+            plan.slots.push_back(std::move(slot));
+        }
+        plan.steps.push_back(std::move(step));
+    }
+
+    for (auto &output : outputs)
+        for (auto &input : output->inputs())
+        {
+            auto slot = slotOf.at(input.lock().get());
+            markRead(slot, plan.steps.size());
+            plan.resultSlots.push_back(slot);
+        }
+    assignArenaOffsets(plan);
+    return plan;
+}
+
+Tensor bindView(const TensorSlot &slot, const Tensor &base)
+{
+    return base.view(slot.shape, slot.strides, slot.elementOffset);
+}
+
+} // runtime
+} // yt
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <graph/traversal.h>
+#include <shape.h>
+#include <tensor.h>
+#include <cstddef>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+struct TensorSlot
+{
+    const graph::TensorDescriptor *descriptor {};
+    DataType dtype {fp32};
+    Shape shape {};
+    Layout layout {Layout::nchw};
+    // Byte offset/size inside the plan's arena; graph inputs are bound to caller tensors instead
+    std::size_t offset {};
+    std::size_t size {};
+    int inputIndex {-1};
+    // Constant values are bound like graph inputs: no arena space and no step; the plan's order keeps
+    // the owning node alive
+    const Tensor *constant {};
+    // Views alias the storage of slot viewOf (never a view itself) instead of owning arena space; the
+    // element at index i lies at elementOffset + sum(i[d] * strides[d]) of it. Contiguous otherwise.
+    std::ptrdiff_t viewOf {-1};
+    Strides strides {};
+    std::ptrdiff_t elementOffset {};
+    // Live range in steps: written by step firstStep, last read by step lastStep
+    std::size_t firstStep {};
+    std::size_t lastStep {};
+};
+
+// Dense copy of a strided view into an arena scratch slot, for a kernel that needs contiguous input
+struct Materialization
+{
+    std::size_t view {};
+    std::size_t slot {};
+};
+
+struct ExecutionStep
+{
+    graph::Node *node {};
+    graph::Node::Kernel kernel {};
+    std::vector<std::size_t> inputs {};
+    std::vector<std::size_t> outputs {};
+    // Performed before the kernel runs; inputs refer to the scratch slots
+    std::vector<Materialization> materializations {};
+};
+
+struct ExecutionPlan
+{
+    std::vector<Shape> inputShapes {};
+    graph::Nodes order {};
+    std::vector<TensorSlot> slots {};
+    std::vector<ExecutionStep> steps {};
+    std::vector<std::size_t> resultSlots {};
+    std::size_t arenaSize {};
+};
+
+// Resolves concrete shapes, picks kernels and assigns arena offsets to intermediate tensors so that
+// tensors with overlapping live ranges never share memory. View outputs become aliasing slots with no
+// step of their own; a view only costs memory where a kernel needs it contiguous.
+ExecutionPlan compileExecutionPlan(const graph::Nodes &inputs, const graph::Nodes &outputs,
+                                   const std::vector<Shape> &inputShapes);
+
+// Tensor of a view slot over the tensor bound to slot.viewOf
+Tensor bindView(const TensorSlot &slot, const Tensor &base);
+
+} // runtime
+} // yt
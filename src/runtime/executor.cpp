@@ -0,0 +1,83 @@
+#include "executor.h"
+#include <kernels/strided.h>
+#include <throw_exception.h>
+#include <string>
+
+namespace yt {
+namespace runtime {
+
+using namespace std::string_literals;
+
+Executor::Executor(graph::Nodes inputs, graph::Nodes outputs, std::size_t planCacheCapacity) :
+    inputs_ {std::move(inputs)},
+    outputs_ {std::move(outputs)},
+    planCache_ {planCacheCapacity}
+{
+}
+
+std::vector<Tensor> Executor::run(const std::vector<Tensor> &inputs)
+{
+    PlanCache::Key key;
+    key.reserve(inputs.size());
+    for (const auto &input : inputs)
+        key.push_back(input.shape());
+    auto plan = planCache_.get(key, [this, &key]() { return compileExecutionPlan(inputs_, outputs_, key); });
+
+    // Pooled, so repeated runs with the same plan reuse the previous run's arena
+    auto arena = allocateAligned(plan->arenaSize);
+    std::vector<Tensor> tensors;
+    tensors.reserve(plan->slots.size());
+    for (const auto &slot : plan->slots)
+    {
+        if (slot.inputIndex >= 0)
+        {
+            const auto &input = inputs[slot.inputIndex];
+            if (input.dataType() != slot.dtype || input.layout() != slot.layout || input.empty())
+                throwException("Executor failure: input #"s + std::to_string(slot.inputIndex) +
+                               " has wrong data type, layout or no storage"s);
+            // The plan assumes dense inputs; strided views passed in are copied once
+            tensors.push_back(input.contiguous());
+        }
+        else if (slot.constant)
+            tensors.push_back(*slot.constant);
+        else if (slot.viewOf >= 0)
+            tensors.push_back(bindView(slot, tensors[slot.viewOf]));
+        else
+            tensors.emplace_back(slot.dtype, slot.shape,
+                                 std::shared_ptr<void>(arena, static_cast<char*>(arena.get()) + slot.offset),
+                                 slot.layout);
+    }
+
+    std::vector<const Tensor*> stepInputs;
+    std::vector<Tensor*> stepOutputs;
+    for (const auto &step : plan->steps)
+    {
+        stepInputs.clear();
+        stepOutputs.clear();
+        for (auto slot : step.inputs)
+            stepInputs.push_back(&tensors[slot]);
+        for (auto slot : step.outputs)
+            stepOutputs.push_back(&tensors[slot]);
+        for (const auto &materialization : step.materializations)
+            kernels::copyStrided(tensors[materialization.view], tensors[materialization.slot]);
+        step.kernel(stepInputs, stepOutputs);
+    }
+
+    std::vector<Tensor> results;
+    results.reserve(plan->resultSlots.size());
+    for (auto slot : plan->resultSlots)
+    {
+        const auto &source = tensors[slot];
+        results.emplace_back(source.dataType(), source.shape(), source.layout());
+        kernels::copyStrided(source, results.back());
+    }
+    return results;
+}
+
+const PlanCache &Executor::planCache() const
+{
+    return planCache_;
+}
+
+} // runtime
+} // yt
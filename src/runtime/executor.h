@@ -0,0 +1,26 @@
+#pragma once
+
+#include "plan_cache.h"
+#include <graph/traversal.h>
+#include <tensor.h>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Runs a graph on concrete tensors; plans are compiled once per input shape signature
+class Executor
+{
+public:
+    Executor(graph::Nodes inputs, graph::Nodes outputs, std::size_t planCacheCapacity = 16);
+    std::vector<Tensor> run(const std::vector<Tensor> &inputs);
+    const PlanCache &planCache() const;
+
+private:
+    graph::Nodes inputs_;
+    graph::Nodes outputs_;
+    PlanCache planCache_;
+};
+
+} // runtime
+} // yt
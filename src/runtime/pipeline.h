@@ -0,0 +1,143 @@
+#pragma once
+
+#include "thread_pool.h"
+#include <throw_exception.h>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Runs a sequence of stages (e.g. load -> forward -> backward -> update) over a stream of
+// batches so that different batches occupy different stages at the same time.
+// Each stage sees batches one at a time and in order, so stateful stages such as reading a
+// dataset stream or applying weight updates need no locking of their own. At most maxInFlight
+// batches exist at once: the first stage is held back until the last one retires a batch.
+// Batch objects live in maxInFlight slots that are reused, so buffers allocated by the first
+// stage survive from one batch to the next. Stages run as tasks on a shared ThreadPool, never
+// on a thread of their own.
+template<typename Batch>
+class Pipeline
+{
+public:
+    using Stage = std::function<void(Batch &batch, std::size_t batchIndex)>;
+
+    Pipeline(ThreadPool &pool, std::size_t maxInFlight) :
+        pool_ {pool},
+        slots_(maxInFlight)
+    {
+        if (!maxInFlight)
+            throwException("Pipeline needs at least one batch in flight");
+    }
+
+    Pipeline &addStage(Stage stage)
+    {
+        stages_.push_back(std::move(stage));
+        return *this;
+    }
+
+    // Pushes numBatches batches through all stages; rethrows the first exception thrown by a stage
+    void run(std::size_t numBatches)
+    {
+        if (stages_.empty())
+            throwException("Pipeline has no stages");
+        std::unique_lock<std::mutex> lock {mutex_};
+        numBatches_ = numBatches;
+        completed_.assign(stages_.size(), 0);
+        busy_.assign(stages_.size(), false);
+        inFlight_ = 0;
+        maxObservedInFlight_ = 0;
+        error_ = nullptr;
+        scheduleLocked();
+        cv_.wait(lock, [this]() { return idleLocked() && (completed_.back() == numBatches_ || error_); });
+        if (error_)
+            std::rethrow_exception(error_);
+    }
+
+    std::size_t maxObservedInFlight() const
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        return maxObservedInFlight_;
+    }
+
+private:
+    bool idleLocked() const
+    {
+        for (auto busy : busy_)
+            if (busy)
+                return false;
+        return true;
+    }
+
+    bool readyLocked(std::size_t stage) const
+    {
+        auto next = completed_[stage];
+        if (busy_[stage] || next >= numBatches_ || error_)
+            return false;
+        if (stage == 0)
+            return inFlight_ < slots_.size();
+        return completed_[stage - 1] > next;
+    }
+
+    void scheduleLocked()
+    {
+        // Later stages first: retiring batches frees slots for the loader
+        for (auto stage = stages_.size(); stage-- > 0;)
+        {
+            if (!readyLocked(stage))
+                continue;
+            auto batchIndex = completed_[stage];
+            busy_[stage] = true;
+            if (stage == 0)
+                maxObservedInFlight_ = std::max(maxObservedInFlight_, ++inFlight_);
+            pool_.submit([this, stage, batchIndex]() { runStage(stage, batchIndex); });
+        }
+    }
+
+    void runStage(std::size_t stage, std::size_t batchIndex)
+    {
+        std::exception_ptr error;
+        try
+        {
+            stages_[stage](slots_[batchIndex % slots_.size()], batchIndex);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock {mutex_};
+        busy_[stage] = false;
+        if (error)
+        {
+            if (!error_)
+                error_ = error;
+        }
+        else
+        {
+            completed_[stage]++;
+            if (stage + 1 == stages_.size())
+                inFlight_--;
+        }
+        scheduleLocked();
+        cv_.notify_all();
+    }
+
+    ThreadPool &pool_;
+    std::vector<Stage> stages_ {};
+    std::vector<Batch> slots_;
+    std::vector<std::size_t> completed_ {};
+    std::vector<bool> busy_ {};
+    std::size_t numBatches_ {};
+    std::size_t inFlight_ {};
+    std::size_t maxObservedInFlight_ {};
+    std::exception_ptr error_ {};
+    mutable std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+};
+
+} // runtime
+} // yt
@@ -0,0 +1,89 @@
+#include "plan_cache.h"
+#include <throw_exception.h>
+
+namespace yt {
+namespace runtime {
+
+std::size_t PlanCache::KeyHash::operator()(const Key &key) const
+{
+    std::size_t seed = key.size();
+    for (const auto &shape : key)
+    {
+        seed ^= shape.size() + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        for (auto dim : shape)
+            seed ^= std::hash<std::size_t>{}(dim) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+PlanCache::PlanCache(std::size_t capacity) :
+    capacity_ {capacity}
+{
+    if (!capacity_)
+        throwException("Plan cache capacity must be positive");
+}
+
+PlanCache::PlanPtr PlanCache::get(const Key &key, const Builder &build)
+{
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        auto found = index_.find(key);
+        if (found != index_.end())
+        {
+            hits_++;
+            entries_.splice(entries_.begin(), entries_, found->second);
+            return found->second->second;
+        }
+        misses_++;
+    }
+    // Planning runs unlocked so that a first-seen shape doesn't stall runs of cached ones
+    auto plan = std::make_shared<const ExecutionPlan>(build());
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto found = index_.find(key);
+    if (found != index_.end())
+    {
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->second;
+    }
+    entries_.emplace_front(key, plan);
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return plan;
+}
+
+void PlanCache::clear()
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    index_.clear();
+    entries_.clear();
+}
+
+std::size_t PlanCache::size() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return entries_.size();
+}
+
+std::size_t PlanCache::capacity() const
+{
+    return capacity_;
+}
+
+std::size_t PlanCache::hits() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return hits_;
+}
+
+std::size_t PlanCache::misses() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return misses_;
+}
+
+} // runtime
+} // yt
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "execution_plan.h"
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+// Bounded LRU of execution plans keyed by the concrete shapes of the graph inputs
+class PlanCache
+{
+public:
+    using Key = std::vector<Shape>;
+    using PlanPtr = std::shared_ptr<const ExecutionPlan>;
+    using Builder = std::function<ExecutionPlan()>;
+
+    explicit PlanCache(std::size_t capacity);
+    PlanPtr get(const Key &key, const Builder &build);
+    void clear();
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t hits() const;
+    std::size_t misses() const;
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+    using Entries = std::list<std::pair<Key, PlanPtr>>;
+
+    std::size_t capacity_;
+    Entries entries_ {};
+    std::unordered_map<Key, Entries::iterator, KeyHash> index_ {};
+    std::size_t hits_ {};
+    std::size_t misses_ {};
+    mutable std::mutex mutex_ {};
+};
+
+} // runtime
+} // yt
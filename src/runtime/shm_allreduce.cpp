@@ -0,0 +1,160 @@
+#include "shm_allreduce.h"
+#include <throw_exception.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace yt {
+namespace runtime {
+
+namespace {
+
+constexpr std::size_t kCacheLine = 64;
+
+std::size_t roundUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void addInto(float *dst, const float *src, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        dst[i] += src[i];
+}
+
+} // namespace
+
+ShmAllreduce::ShmAllreduce(std::size_t numRanks, std::size_t maxElements) :
+    numRanks_ {numRanks},
+    maxElements_ {roundUp(std::max<std::size_t>(maxElements, 1), kCacheLine / sizeof(float))},
+    mappingSize_ {kCacheLine + numRanks * maxElements_ * sizeof(float)}
+{
+    if (!numRanks_)
+        throwException("ShmAllreduce needs at least one rank");
+    auto name = "/yt_allreduce_" + std::to_string(::getpid()) + "_" + std::to_string(std::random_device{}());
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throwException("ShmAllreduce: shm_open failed for " + name);
+    // Forked workers inherit the mapping, the name itself is not needed after this point
+    ::shm_unlink(name.c_str());
+    if (::ftruncate(fd, static_cast<off_t>(mappingSize_)) != 0)
+    {
+        ::close(fd);
+        throwException("ShmAllreduce: cannot size shared memory segment");
+    }
+    mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        throwException("ShmAllreduce: mmap failed");
+    }
+    new (mapping_) Header{{0}, {0}, {0}};
+}
+
+ShmAllreduce::~ShmAllreduce()
+{
+    if (mapping_)
+        ::munmap(mapping_, mappingSize_);
+}
+
+std::size_t ShmAllreduce::numRanks() const
+{
+    return numRanks_;
+}
+
+float *ShmAllreduce::buffer(std::size_t rank) const
+{
+    return reinterpret_cast<float*>(static_cast<char*>(mapping_) + kCacheLine) + rank * maxElements_;
+}
+
+void ShmAllreduce::abort()
+{
+    static_cast<Header*>(mapping_)->aborted.store(1, std::memory_order_release);
+}
+
+void ShmAllreduce::barrier()
+{
+    auto header = static_cast<Header*>(mapping_);
+    if (header->aborted.load(std::memory_order_acquire))
+        throwException("ShmAllreduce: collective aborted by another rank");
+    auto generation = header->generation.load(std::memory_order_acquire);
+    if (header->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == numRanks_)
+    {
+        header->arrived.store(0, std::memory_order_relaxed);
+        header->generation.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    for (unsigned spins = 0; header->generation.load(std::memory_order_acquire) == generation; spins++)
+    {
+        if (header->aborted.load(std::memory_order_acquire))
+            throwException("ShmAllreduce: collective aborted by another rank");
+        if (spins > 128)
+            std::this_thread::yield();
+    }
+}
+
+void ShmAllreduce::allreduce(std::size_t rank, float *data, std::size_t count)
+{
+    if (rank >= numRanks_ || count > maxElements_)
+        throwException("ShmAllreduce: rank or element count out of range");
+    if (numRanks_ == 1)
+        return;
+    auto own = buffer(rank);
+    auto left = buffer((rank + numRanks_ - 1) % numRanks_);
+    std::memcpy(own, data, count * sizeof(float));
+    // Chunks are cache line multiples so that neighbouring ranks never write the same line
+    auto chunkSize = roundUp((count + numRanks_ - 1) / numRanks_, kCacheLine / sizeof(float));
+    auto chunk = [&](std::size_t index, std::size_t &begin, std::size_t &length) {
+        begin = std::min(count, (index % numRanks_) * chunkSize);
+        length = std::min(count, begin + chunkSize) - begin;
+    };
+    barrier();
+    for (std::size_t step = 0; step + 1 < numRanks_; step++)
+    {
+        // After the last step rank r holds the complete sum of chunk r + 1
+        std::size_t begin, length;
+        chunk(rank + 2 * numRanks_ - step - 1, begin, length);
+        addInto(own + begin, left + begin, length);
+        barrier();
+    }
+    for (std::size_t step = 0; step + 1 < numRanks_; step++)
+    {
+        std::size_t begin, length;
+        chunk(rank + 2 * numRanks_ - step, begin, length);
+        std::memcpy(own + begin, left + begin, length * sizeof(float));
+        barrier();
+    }
+    std::memcpy(data, own, count * sizeof(float));
+    // Nobody may overwrite its buffer for the next collective while a neighbour still reads it
+    barrier();
+}
+
+void ShmAllreduce::broadcast(std::size_t rank, float *data, std::size_t count)
+{
+    if (rank >= numRanks_ || count > maxElements_)
+        throwException("ShmAllreduce: rank or element count out of range");
+    if (rank == 0)
+        std::memcpy(buffer(0), data, count * sizeof(float));
+    barrier();
+    if (rank != 0)
+        std::memcpy(data, buffer(0), count * sizeof(float));
+    barrier();
+}
+
+ShardRange shardOf(std::size_t rank, std::size_t numRanks, std::size_t datasetSize)
+{
+    auto base = datasetSize / numRanks;
+    auto remainder = datasetSize % numRanks;
+    auto begin = rank * base + std::min(rank, remainder);
+    return {begin, begin + base + (rank < remainder ? 1 : 0)};
+}
+
+} // runtime
+} // yt
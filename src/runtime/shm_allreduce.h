@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace yt {
+namespace runtime {
+
+// Sum-allreduce between the processes of one host through a POSIX shared memory segment.
+// The segment is created by the parent before forking the workers, which inherit the mapping.
+// Every rank owns a buffer in the segment; the reduction is a ring over those buffers:
+// numRanks - 1 reduce-scatter steps in which each rank adds one chunk of its left neighbour's
+// buffer into its own, then numRanks - 1 allgather steps in which it copies the fully reduced
+// chunks around the ring. Ranks synchronize on a spinning barrier between steps.
+class ShmAllreduce
+{
+public:
+    ShmAllreduce(std::size_t numRanks, std::size_t maxElements);
+    ~ShmAllreduce();
+    ShmAllreduce(const ShmAllreduce &) = delete;
+    ShmAllreduce &operator=(const ShmAllreduce &) = delete;
+
+    // Collective: every rank must call it with the same count. On return data holds the sum over ranks.
+    void allreduce(std::size_t rank, float *data, std::size_t count);
+    // Collective: rank 0's data is copied to every rank
+    void broadcast(std::size_t rank, float *data, std::size_t count);
+    // Makes every rank waiting in (or later entering) a collective throw, so that the failure of
+    // one worker doesn't leave the others spinning forever
+    void abort();
+    std::size_t numRanks() const;
+
+private:
+    struct Header
+    {
+        std::atomic<std::uint32_t> arrived;
+        std::atomic<std::uint32_t> generation;
+        std::atomic<std::uint32_t> aborted;
+    };
+
+    void barrier();
+    float *buffer(std::size_t rank) const;
+
+    std::size_t numRanks_;
+    std::size_t maxElements_;
+    std::size_t mappingSize_;
+    void *mapping_ {};
+};
+
+struct ShardRange
+{
+    std::size_t begin;
+    std::size_t end;
+};
+
+// Contiguous, disjoint part of [0, datasetSize) for one rank; sizes differ by at most one
+ShardRange shardOf(std::size_t rank, std::size_t numRanks, std::size_t datasetSize);
+
+} // runtime
+} // yt
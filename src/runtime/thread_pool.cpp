@@ -0,0 +1,111 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace yt {
+namespace runtime {
+
+ThreadPool::ThreadPool(std::size_t numThreads)
+{
+    numThreads = std::max<std::size_t>(numThreads, 1);
+    workers_.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; i++)
+        workers_.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end,
+                             const std::function<void(std::size_t, std::size_t)> &body, std::size_t grain)
+{
+    if (begin >= end)
+        return;
+    grain = std::max<std::size_t>(grain, 1);
+    auto numChunks = std::min((end - begin + grain - 1) / grain, workers_.size() * 4);
+    auto chunkSize = (end - begin + numChunks - 1) / numChunks;
+    numChunks = (end - begin + chunkSize - 1) / chunkSize;
+
+    struct State
+    {
+        std::atomic<std::size_t> next {};
+        std::size_t done {};
+        std::exception_ptr error {};
+        std::mutex mutex {};
+        std::condition_variable cv {};
+    };
+    auto state = std::make_shared<State>();
+    auto work = [state, begin, end, chunkSize, numChunks, &body]() {
+        for (auto chunk = state->next++; chunk < numChunks; chunk = state->next++)
+        {
+            std::exception_ptr error;
+            try
+            {
+                auto chunkBegin = begin + chunk * chunkSize;
+                body(chunkBegin, std::min(end, chunkBegin + chunkSize));
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock {state->mutex};
+            if (error && !state->error)
+                state->error = error;
+            if (++state->done == numChunks)
+                state->cv.notify_all();
+        }
+    };
+    // Helpers that start after all chunks are claimed return immediately, so body is never
+    // touched once the caller has returned
+    for (std::size_t i = 1; i < std::min(numChunks, workers_.size() + 1); i++)
+        submit(work);
+    work();
+    std::unique_lock<std::mutex> lock {state->mutex};
+    state->cv.wait(lock, [&state, numChunks]() { return state->done == numChunks; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers_.size();
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock {mutex_};
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // runtime
+} // yt
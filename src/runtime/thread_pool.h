@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yt {
+namespace runtime {
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t numThreads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+    // Splits [begin, end) into chunks of at least grain items and blocks until all are processed.
+    // The caller works on chunks too, so it is safe to call from inside a pool task.
+    void parallelFor(std::size_t begin, std::size_t end, const std::function<void(std::size_t, std::size_t)> &body,
+                     std::size_t grain = 1);
+    std::size_t size() const;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_ {};
+    std::deque<std::function<void()>> tasks_ {};
+    std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    bool stopping_ {false};
+};
+
+} // runtime
+} // yt
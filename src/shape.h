@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <memory>
 
@@ -19,10 +22,100 @@ enum DataType
     uint64,
 };
 
+constexpr std::size_t dataTypeSize(DataType dtype)
+{
+    switch (dtype)
+    {
+    case fp16:
+    case int16:
+    case uint16:
+        return 2;
+    case fp32:
+    case int32:
+    case uint32:
+        return 4;
+    case int64:
+    case uint64:
+        return 8;
+    case int8:
+    case uint8:
+    default:
+        return 1;
+    }
+}
+
+// Marks the symbolic batch dimension; its value is only known once concrete inputs are bound
+constexpr std::size_t kDynamicDim = std::numeric_limits<std::size_t>::max();
+
 class Shape : public std::vector<std::size_t>
 {
 public:
     using std::vector<std::size_t>::vector;
+
+    bool isDynamic() const
+    {
+        for (auto dim : *this)
+            if (dim == kDynamicDim)
+                return true;
+        return false;
+    }
+
+    std::size_t numElements() const
+    {
+        std::size_t result {1};
+        for (auto dim : *this)
+            result *= dim;
+        return result;
+    }
+};
+
+// Physical order of a 4D activation. The logical shape stays [N, C, H, W] in every layout; nChw8c
+// stores channels in blocks of kChannelBlock innermost ([N, C/8, H, W, 8]), the last block zero-padded.
+enum class Layout
+{
+    nchw,
+    nhwc,
+    nChw8c,
 };
 
+constexpr std::size_t kChannelBlock = 8;
+
+// Number of elements a tensor of the given logical shape occupies in memory, including block padding
+inline std::size_t storageElements(const Shape &shape, Layout layout)
+{
+    if (layout != Layout::nChw8c || shape.size() != 4)
+        return shape.numElements();
+    auto paddedChannels = (shape[1] + kChannelBlock - 1) / kChannelBlock * kChannelBlock;
+    return shape[0] * paddedChannels * shape[2] * shape[3];
+}
+
+// Element distance between neighbours along each dimension of a strided (nchw) view. A stride of 0
+// repeats one element along a broadcast dimension.
+using Strides = std::vector<std::ptrdiff_t>;
+
+inline Strides contiguousStrides(const Shape &shape)
+{
+    Strides strides(shape.size());
+    std::ptrdiff_t stride {1};
+    for (auto i = shape.size(); i-- > 0;)
+    {
+        strides[i] = stride;
+        stride *= static_cast<std::ptrdiff_t>(shape[i]);
+    }
+    return strides;
+}
+
+// Dimensions of size 1 never move, so their strides don't matter
+inline bool isContiguous(const Shape &shape, const Strides &strides)
+{
+    std::ptrdiff_t expected {1};
+    for (auto i = shape.size(); i-- > 0;)
+    {
+        if (shape[i] != 1 && strides[i] != expected)
+            return false;
+        expected *= static_cast<std::ptrdiff_t>(shape[i]);
+    }
+    return true;
+}
+
 } // yt_ml_toolkit
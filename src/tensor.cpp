@@ -0,0 +1,117 @@
+#include "tensor.h"
+#include "buffer_pool.h"
+#include "throw_exception.h"
+#include <kernels/convert.h>
+#include <kernels/strided.h>
+
+namespace yt {
+
+std::shared_ptr<void> allocateAligned(std::size_t sizeInBytes)
+{
+    return BufferPool::instance().allocate(sizeInBytes);
+}
+
+Tensor::Tensor(DataType dtype, Shape shape, Layout layout) :
+    dtype_ {dtype},
+    shape_ {std::move(shape)},
+    layout_ {layout},
+    storage_ {allocateAligned(sizeInBytes())}
+{
+}
+
+Tensor::Tensor(DataType dtype, Shape shape, std::shared_ptr<void> storage, Layout layout) :
+    dtype_ {dtype},
+    shape_ {std::move(shape)},
+    layout_ {layout},
+    storage_ {std::move(storage)}
+{
+}
+
+DataType Tensor::dataType() const
+{
+    return dtype_;
+}
+
+const Shape &Tensor::shape() const
+{
+    return shape_;
+}
+
+Layout Tensor::layout() const
+{
+    return layout_;
+}
+
+std::size_t Tensor::numElements() const
+{
+    return shape_.numElements();
+}
+
+std::size_t Tensor::sizeInBytes() const
+{
+    return storageElements(shape_, layout_) * dataTypeSize(dtype_);
+}
+
+bool Tensor::empty() const
+{
+    return !storage_;
+}
+
+void *Tensor::data()
+{
+    return storage_.get();
+}
+
+const void *Tensor::data() const
+{
+    return storage_.get();
+}
+
+Strides Tensor::strides() const
+{
+    return strides_.empty() ? contiguousStrides(shape_) : strides_;
+}
+
+bool Tensor::isContiguous() const
+{
+    return strides_.empty();
+}
+
+Tensor Tensor::view(Shape shape, Strides strides, std::ptrdiff_t offset) const
+{
+    if (empty())
+        throwException("Tensor view failure: tensor has no storage");
+    if (layout_ != Layout::nchw)
+        throwException("Tensor view failure: views of blocked or channel-last layouts are not supported");
+    if (strides.size() != shape.size())
+        throwException("Tensor view failure: expected one stride per dimension");
+    auto first = static_cast<const char*>(storage_.get()) + offset * static_cast<std::ptrdiff_t>(dataTypeSize(dtype_));
+    Tensor result {dtype_, std::move(shape), std::shared_ptr<void>(storage_, const_cast<char*>(first))};
+    if (!yt::isContiguous(result.shape_, strides))
+        result.strides_ = std::move(strides);
+    return result;
+}
+
+Tensor Tensor::contiguous() const
+{
+    if (isContiguous())
+        return *this;
+    Tensor result {dtype_, shape_};
+    kernels::copyStrided(*this, result);
+    return result;
+}
+
+Tensor Tensor::toDataType(DataType dtype) const
+{
+    if (empty())
+        throwException("Tensor conversion failure: tensor has no storage");
+    if (!isContiguous())
+        throwException("Tensor conversion failure: strided views must be made contiguous first");
+    if (storageElements(shape_, layout_) != numElements())
+        throwException("Tensor conversion failure: blocked layouts must be reordered first");
+    Tensor result {dtype, shape_, layout_};
+    kernels::convert(*this, 0, numElements(), result, 0);
+    return result;
+}
+
+} // yt_ml_toolkit
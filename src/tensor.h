@@ -0,0 +1,57 @@
+#pragma once
+
+#include "shape.h"
+#include <cstddef>
+#include <memory>
+
+namespace yt {
+
+class Tensor
+{
+public:
+    static constexpr std::size_t kAlignment = 64;
+
+    Tensor() = default;
+    Tensor(DataType dtype, Shape shape, Layout layout = Layout::nchw);
+    Tensor(DataType dtype, Shape shape, std::shared_ptr<void> storage, Layout layout = Layout::nchw);
+
+    DataType dataType() const;
+    const Shape &shape() const;
+    Layout layout() const;
+    // Logical element count; blocked layouts may occupy more, see sizeInBytes()
+    std::size_t numElements() const;
+    // Bytes of storage for contiguous tensors, of the logical elements for strided views
+    std::size_t sizeInBytes() const;
+    bool empty() const;
+
+    void *data();
+    const void *data() const;
+    template<typename T> T *data() { return static_cast<T*>(data()); }
+    template<typename T> const T *data() const { return static_cast<const T*>(data()); }
+
+    // Element strides; strided views are always nchw. Plain tensors report the contiguous strides.
+    Strides strides() const;
+    bool isContiguous() const;
+    // Zero-copy view sharing this tensor's storage: element [i...] of the view is element
+    // offset + sum(i[d] * strides[d]) of this tensor's storage, counted from data()
+    Tensor view(Shape shape, Strides strides, std::ptrdiff_t offset = 0) const;
+    // This tensor if it is contiguous, otherwise a dense copy of the view
+    Tensor contiguous() const;
+
+    // Returns a copy converted element-wise to dtype (fp16 <-> fp32 goes through the F16C kernels).
+    // The layout is kept; blocked layouts and strided views are not supported.
+    Tensor toDataType(DataType dtype) const;
+
+private:
+    DataType dtype_ {fp32};
+    Shape shape_ {};
+    Layout layout_ {Layout::nchw};
+    // Empty for contiguous tensors, so plain tensors don't pay for them
+    Strides strides_ {};
+    std::shared_ptr<void> storage_ {};
+};
+
+// Storage comes from BufferPool and returns to it when the last owner releases it
+std::shared_ptr<void> allocateAligned(std::size_t sizeInBytes);
+
+} // yt_ml_toolkit
@@ -0,0 +1,113 @@
+#include <dataset/augmentation.h>
+#include <runtime/thread_pool.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+using yt::dataset::AugmentationOptions;
+using yt::dataset::Augmenter;
+
+namespace {
+
+constexpr int kSide = 28;
+
+std::vector<unsigned char> makeImages(int count)
+{
+    std::vector<unsigned char> images(count * kSide * kSide, 0);
+    for (int i = 0; i < count; i++)
+        for (int y = 10; y < 18; y++)
+            for (int x = 8 + i % 4; x < 20; x++)
+                images[i * kSide * kSide + y * kSide + x] = static_cast<unsigned char>(128 + x * 4);
+    return images;
+}
+
+void centroid(const float *image, float &cx, float &cy)
+{
+    float mass {};
+    cx = cy = 0.f;
+    for (int y = 0; y < kSide; y++)
+        for (int x = 0; x < kSide; x++)
+        {
+            mass += image[y * kSide + x];
+            cx += x * image[y * kSide + x];
+            cy += y * image[y * kSide + x];
+        }
+    cx /= mass;
+    cy /= mass;
+}
+
+} // namespace
+
+
+TEST(AugmentationTest, IdentityTransformNormalizesPixels)
+{
+    AugmentationOptions options {0.f, 0.f, 1.f, 1.f, 0.f, 4.f, 0.f};
+    Augmenter augmenter {kSide, kSide, options, 1};
+    auto images = makeImages(1);
+    std::vector<float> out(kSide * kSide);
+    augmenter.augmentImage(images.data(), out.data(), 0);
+    for (int i = 0; i < kSide * kSide; i++)
+        ASSERT_FLOAT_EQ(out[i], images[i] / 255.f) << i;
+}
+
+
+TEST(AugmentationTest, ShiftMovesCentroidWithinBounds)
+{
+    AugmentationOptions options {3.f, 0.f, 1.f, 1.f, 0.f, 4.f, 0.f};
+    Augmenter augmenter {kSide, kSide, options, 7};
+    auto images = makeImages(1);
+    std::vector<float> reference(kSide * kSide), out(kSide * kSide);
+    for (int i = 0; i < kSide * kSide; i++)
+        reference[i] = images[i] / 255.f;
+    float refX, refY;
+    centroid(reference.data(), refX, refY);
+    bool moved {false};
+    for (std::uint64_t sample = 0; sample < 20; sample++)
+    {
+        augmenter.augmentImage(images.data(), out.data(), sample);
+        float x, y;
+        centroid(out.data(), x, y);
+        EXPECT_LE(std::abs(x - refX), 3.01f);
+        EXPECT_LE(std::abs(y - refY), 3.01f);
+        moved = moved || std::abs(x - refX) > 0.1f;
+    }
+    EXPECT_TRUE(moved);
+}
+
+
+TEST(AugmentationTest, PerSampleSeedingIsReproducible)
+{
+    AugmentationOptions options;
+    options.elasticAlpha = 2.f;
+    options.noiseStddev = 0.05f;
+    Augmenter augmenter {kSide, kSide, options, 42};
+    constexpr int kImages = 16;
+    auto images = makeImages(kImages);
+    std::vector<float> serial(images.size()), parallel(images.size());
+    augmenter.augmentBatch(images.data(), kImages, serial.data(), 100);
+    yt::runtime::ThreadPool pool {4};
+    augmenter.augmentBatch(images.data(), kImages, parallel.data(), 100, &pool);
+    EXPECT_EQ(serial, parallel);
+
+    std::vector<float> single(kSide * kSide);
+    augmenter.augmentImage(images.data() + 5 * kSide * kSide, single.data(), 105);
+    EXPECT_TRUE(std::equal(single.begin(), single.end(), serial.begin() + 5 * kSide * kSide));
+    augmenter.augmentImage(images.data() + 5 * kSide * kSide, single.data(), 106);
+    EXPECT_FALSE(std::equal(single.begin(), single.end(), serial.begin() + 5 * kSide * kSide));
+    for (auto value : serial)
+    {
+        EXPECT_GE(value, 0.f);
+        EXPECT_LE(value, 1.f);
+    }
+}
+
+
+TEST(AugmentationTest, InvalidOptionsThrow)
+{
+    AugmentationOptions options;
+    options.minScale = 0.f;
+    EXPECT_THROW((Augmenter{kSide, kSide, options, 0}), std::invalid_argument);
+    EXPECT_THROW((Augmenter{0, kSide, AugmentationOptions{}, 0}), std::invalid_argument);
+}
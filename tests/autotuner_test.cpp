@@ -0,0 +1,168 @@
+#include <graph/constant.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <kernels/autotuner.h>
+#include <kernels/gemm.h>
+#include <runtime/execution_plan.h>
+#include <throw_exception.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <gtest/gtest.h>
+
+using yt::kernels::Autotuner;
+using yt::kernels::TuningKey;
+
+namespace {
+
+// Candidate i sleeps for the given number of milliseconds
+Autotuner::Benchmark sleeper(std::vector<int> milliseconds, std::vector<int> &calls)
+{
+    calls.assign(milliseconds.size(), 0);
+    return [milliseconds, &calls](std::size_t candidate) {
+        calls[candidate]++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds[candidate]));
+    };
+}
+
+} // namespace
+
+
+class AutotunerTest : public ::testing::Test
+{
+protected:
+    ~AutotunerTest() override
+    {
+        std::remove(cachePath_.c_str());
+    }
+
+    const TuningKey key_ {"conv", {1, 64, 56, 56}, yt::fp32};
+    const std::vector<std::string> candidates_ {"slow", "fast", "medium"};
+    const std::string cachePath_ {"/tmp/yt_autotuner_test_" + std::to_string(getpid())};
+    std::vector<int> calls_ {};
+};
+
+
+TEST_F(AutotunerTest, BenchmarksOnceAndRemembersTheWinner)
+{
+    Autotuner tuner;
+    EXPECT_FALSE(tuner.lookup(key_));
+    EXPECT_EQ(tuner.select(key_, candidates_, sleeper({6, 1, 3}, calls_)), 1);
+    EXPECT_EQ(calls_, (std::vector<int>{4, 4, 4}));
+    EXPECT_EQ(tuner.lookup(key_), "fast");
+    EXPECT_EQ(tuner.size(), 1);
+    EXPECT_EQ(tuner.tuned(), 1);
+
+    // Cached by name: a reordered list still finds the winner without benchmarking
+    EXPECT_EQ(tuner.select(key_, {"medium", "fast"}, sleeper({0, 0}, calls_)), 1);
+    EXPECT_EQ(calls_, (std::vector<int>{0, 0}));
+    // Other shapes and dtypes are separate keys
+    EXPECT_EQ(tuner.select({"conv", {2, 64, 56, 56}, yt::fp32}, candidates_, sleeper({1, 6, 3}, calls_)), 0);
+    EXPECT_EQ(tuner.select({"conv", {1, 64, 56, 56}, yt::fp16}, candidates_, sleeper({6, 3, 1}, calls_)), 2);
+    EXPECT_EQ(tuner.tuned(), 3);
+    EXPECT_THROW(tuner.select(key_, {}, sleeper({}, calls_)), yt::Exception);
+}
+
+
+TEST_F(AutotunerTest, DisabledTunerFallsBackToTheFirstCandidate)
+{
+    Autotuner tuner;
+    tuner.setEnabled(false);
+    EXPECT_EQ(tuner.select(key_, candidates_, sleeper({6, 1, 3}, calls_)), 0);
+    EXPECT_EQ(calls_, (std::vector<int>{0, 0, 0}));
+    EXPECT_FALSE(tuner.lookup(key_));
+}
+
+
+TEST_F(AutotunerTest, PersistsResultsAcrossProcesses)
+{
+    {
+        Autotuner tuner {cachePath_};
+        EXPECT_EQ(tuner.select(key_, candidates_, sleeper({6, 1, 3}, calls_)), 1);
+    }
+    {
+        // A result recorded on another CPU model and a torn trailing line are ignored
+        std::ofstream file {cachePath_, std::ios::app};
+        file << "Other CPU\tconv\t1\t1x64x56x56\tslow\n" << Autotuner::cpuModel() << "\tconv\t1\t1x6";
+    }
+
+    Autotuner worker {cachePath_};
+    EXPECT_EQ(worker.size(), 1);
+    EXPECT_EQ(worker.select(key_, candidates_, sleeper({0, 0, 0}, calls_)), 1);
+    EXPECT_EQ(calls_, (std::vector<int>{0, 0, 0}));
+    EXPECT_EQ(worker.tuned(), 0);
+
+    // save() rewrites the file with every entry, the other CPU's one included
+    worker.save(cachePath_);
+    Autotuner reloaded;
+    EXPECT_TRUE(reloaded.load(cachePath_));
+    EXPECT_EQ(reloaded.lookup(key_), "fast");
+    std::ifstream file {cachePath_};
+    std::string line;
+    int lines {};
+    while (std::getline(file, line))
+        lines++;
+    EXPECT_EQ(lines, 2);
+    EXPECT_FALSE(reloaded.load(cachePath_ + ".missing"));
+}
+
+
+TEST(GemmTest, AllTilingsAgreeWithNaiveProduct)
+{
+    std::size_t m = 7, n = 300, k = 150;
+    std::mt19937 gen {1};
+    std::uniform_real_distribution<float> distrib {-1.f, 1.f};
+    std::vector<float> a(m * k), b(k * n), expected(m * n);
+    for (auto &value : a)
+        value = distrib(gen);
+    for (auto &value : b)
+        value = distrib(gen);
+    for (std::size_t i = 0; i < m; i++)
+        for (std::size_t p = 0; p < k; p++)
+            for (std::size_t j = 0; j < n; j++)
+                expected[i * n + j] += a[i * k + p] * b[p * n + j];
+
+    std::vector<float> tuned(m * n, 1.f);
+    yt::kernels::gemm(m, n, k, a.data(), b.data(), tuned.data(), false, yt::kernels::tunedGemmTiling(m, n, k));
+    for (const auto &tiling : yt::kernels::gemmTilings())
+    {
+        std::vector<float> c(m * n, 1.f);
+        yt::kernels::gemm(m, n, k, a.data(), b.data(), c.data(), true, tiling);
+        for (std::size_t i = 0; i < m * n; i++)
+            ASSERT_NEAR(c[i], expected[i] + 1.f, 1e-4f) << tiling.name();
+        // Every tiling sums in the same order, so the tuned choice never changes results
+        yt::kernels::gemm(m, n, k, a.data(), b.data(), c.data(), false, tiling);
+        EXPECT_EQ(c, tuned) << tiling.name();
+    }
+    EXPECT_TRUE(yt::kernels::Autotuner::instance().lookup({"gemm", {m, n, k}, yt::fp32}) ||
+                !yt::kernels::Autotuner::instance().enabled());
+}
+
+
+TEST(GemmTest, CallsDoNotReachTheAutotuner)
+{
+    std::size_t m = 5, n = 400, k = 160;
+    std::vector<float> a(m * k, 1.f), b(k * n, 1.f), c(m * n);
+    yt::kernels::gemm(m, n, k, a.data(), b.data(), c.data());
+    EXPECT_FLOAT_EQ(c.back(), static_cast<float>(k));
+    EXPECT_FALSE(yt::kernels::Autotuner::instance().lookup({"gemm", {m, n, k}, yt::fp32}));
+}
+
+
+TEST(GemmTest, DenseResolvesItsTilingWhenCompiled)
+{
+    std::size_t rows = 6, in = 96, out = 136;
+    auto x = std::make_shared<yt::graph::Input>(yt::fp32, yt::Shape{rows, in});
+    auto w = std::make_shared<yt::graph::Constant>(yt::Tensor{yt::fp32, {in, out}});
+    auto b = std::make_shared<yt::graph::Constant>(yt::Tensor{yt::fp32, {out}});
+    auto dense = std::make_shared<yt::graph::Dense>(*x, *w, *b);
+    auto y = std::make_shared<yt::graph::Output>(*dense);
+    yt::runtime::compileExecutionPlan({x}, {y}, {{rows, in}});
+    EXPECT_TRUE(Autotuner::instance().lookup({"gemm", {rows, out, in}, yt::fp32}) || !Autotuner::instance().enabled());
+}
@@ -0,0 +1,175 @@
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/pooling.h>
+#include <kernels/reorder.h>
+#include <runtime/batching_front_end.h>
+#include <throw_exception.h>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+using yt::runtime::BatchingFrontEnd;
+using yt::runtime::Executor;
+
+namespace batching_fakes {
+
+// Doubles every element and counts how many times its kernel ran
+class Twice : public Node
+{
+public:
+    Twice(const TensorDescriptor::WeakPtr &a, std::shared_ptr<std::atomic<int>> runs) :
+        Node(std::move(std::vector<TensorDescriptor::WeakPtr>{a}), "twice"),
+        runs_ {std::move(runs)}
+    {
+        auto aPtr = a.lock();
+        outputs_.push_back(std::make_shared<TensorDescriptor>(aPtr->dataType(), aPtr->shape(), this));
+    }
+
+    Kernel kernel(const std::vector<yt::Shape> &) const override
+    {
+        return [runs = runs_](const std::vector<const yt::Tensor*> &in, const std::vector<yt::Tensor*> &out) {
+            (*runs)++;
+            for (std::size_t i = 0; i < out[0]->numElements(); i++)
+                out[0]->data<float>()[i] = 2.f * in[0]->data<float>()[i];
+        };
+    }
+
+private:
+    std::shared_ptr<std::atomic<int>> runs_;
+};
+
+yt::Tensor makeSample(std::size_t rows, float value)
+{
+    yt::Tensor tensor {yt::DataType::fp32, {rows, 2}};
+    for (std::size_t i = 0; i < tensor.numElements(); i++)
+        tensor.data<float>()[i] = value + i;
+    return tensor;
+}
+
+} // namespace batching_fakes
+
+
+class BatchingFrontEndTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<std::atomic<int>> runs = std::make_shared<std::atomic<int>>(0);
+    std::shared_ptr<Input> x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 2}, "x");
+    std::shared_ptr<Node> twice = std::make_shared<batching_fakes::Twice>(*x, runs);
+    std::shared_ptr<Node> result = std::make_shared<Output>(*twice, "result");
+    Executor executor {{x}, {result}};
+};
+
+
+TEST_F(BatchingFrontEndTest, CoalescesConcurrentRequests)
+{
+    using namespace std::chrono_literals;
+    BatchingFrontEnd frontEnd {executor, {8, 10s}};
+    std::vector<std::future<std::vector<yt::Tensor>>> futures;
+    std::vector<std::thread> clients;
+    std::mutex mutex;
+    for (int i = 0; i < 8; i++)
+        clients.emplace_back([&, i]() {
+            auto future = frontEnd.submit({batching_fakes::makeSample(1, 10.f * i)});
+            std::lock_guard<std::mutex> lock {mutex};
+            futures.push_back(std::move(future));
+        });
+    for (auto &client : clients)
+        client.join();
+    std::vector<float> firsts;
+    for (auto &future : futures)
+    {
+        auto outputs = future.get();
+        ASSERT_EQ(outputs.size(), 1);
+        ASSERT_THAT(outputs[0].shape(), ::testing::ElementsAre(1, 2));
+        EXPECT_FLOAT_EQ(outputs[0].data<float>()[1], outputs[0].data<float>()[0] + 2.f);
+        firsts.push_back(outputs[0].data<float>()[0] / 2.f);
+    }
+    ASSERT_THAT(firsts, ::testing::UnorderedElementsAre(0.f, 10.f, 20.f, 30.f, 40.f, 50.f, 60.f, 70.f));
+    EXPECT_EQ(runs->load(), 1);
+    EXPECT_EQ(frontEnd.batchesRun(), 1);
+    EXPECT_EQ(executor.planCache().misses(), 1);
+}
+
+
+TEST_F(BatchingFrontEndTest, FlushesAfterMaxWait)
+{
+    using namespace std::chrono_literals;
+    BatchingFrontEnd frontEnd {executor, {64, 1ms}};
+    auto first = frontEnd.submit({batching_fakes::makeSample(2, 1.f)});
+    ASSERT_EQ(first.wait_for(5s), std::future_status::ready);
+    auto outputs = first.get();
+    ASSERT_THAT(outputs[0].shape(), ::testing::ElementsAre(2, 2));
+    EXPECT_FLOAT_EQ(outputs[0].data<float>()[3], 8.f);
+}
+
+
+TEST_F(BatchingFrontEndTest, SplitsIncompatibleRequests)
+{
+    using namespace std::chrono_literals;
+    BatchingFrontEnd frontEnd {executor, {4, 20ms}};
+    auto a = frontEnd.submit({batching_fakes::makeSample(3, 0.f)});
+    auto b = frontEnd.submit({batching_fakes::makeSample(3, 100.f)});
+    auto c = frontEnd.submit({yt::Tensor{yt::DataType::fp32, {1, 3}}});
+    EXPECT_FLOAT_EQ(a.get()[0].data<float>()[5], 10.f);
+    EXPECT_FLOAT_EQ(b.get()[0].data<float>()[0], 200.f);
+    EXPECT_THROW(c.get(), yt::Exception);
+    EXPECT_THROW(frontEnd.submit({}).get(), yt::Exception);
+}
+
+
+TEST_F(BatchingFrontEndTest, StacksStridedViews)
+{
+    using namespace std::chrono_literals;
+    BatchingFrontEnd frontEnd {executor, {4, 10s}};
+    auto base = batching_fakes::makeSample(2, 1.f);
+    auto transposed = base.view({2, 2}, {1, 2});
+    auto a = frontEnd.submit({batching_fakes::makeSample(2, 0.f)});
+    auto b = frontEnd.submit({transposed});
+    auto plain = a.get()[0];
+    auto strided = b.get()[0];
+    EXPECT_THAT(std::vector<float>(plain.data<float>(), plain.data<float>() + 4),
+                ::testing::ElementsAre(0.f, 2.f, 4.f, 6.f));
+    EXPECT_THAT(std::vector<float>(strided.data<float>(), strided.data<float>() + 4),
+                ::testing::ElementsAre(2.f, 6.f, 4.f, 8.f));
+    EXPECT_EQ(frontEnd.batchesRun(), 1);
+}
+
+
+TEST(BatchingFrontEndLayoutTest, StacksBlockedLayouts)
+{
+    using namespace std::chrono_literals;
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 5, 3, 3}, "x");
+    x->outputs()[0]->setLayout(yt::Layout::nChw8c);
+    auto pool = std::make_shared<MaxPool2D>(*x, 2, 1);
+    pool->outputs()[0]->setLayout(yt::Layout::nChw8c);
+    auto result = std::make_shared<Output>(*pool);
+    Executor executor {{x}, {result}};
+    auto blocked = [](float start) {
+        yt::Tensor plain {yt::fp32, {1, 5, 3, 3}};
+        for (std::size_t i = 0; i < plain.numElements(); i++)
+            plain.data<float>()[i] = start + static_cast<float>(i * 7 % 11);
+        yt::Tensor tensor {yt::fp32, plain.shape(), yt::Layout::nChw8c};
+        yt::kernels::reorder(plain, tensor);
+        return tensor;
+    };
+
+    BatchingFrontEnd frontEnd {executor, {2, 10s}};
+    auto a = frontEnd.submit({blocked(0.f)});
+    auto b = frontEnd.submit({blocked(100.f)});
+    auto batchedA = a.get();
+    auto batchedB = b.get();
+    EXPECT_EQ(frontEnd.batchesRun(), 1);
+    for (auto [batched, start] : {std::make_pair(&batchedA, 0.f), std::make_pair(&batchedB, 100.f)})
+    {
+        auto alone = executor.run({blocked(start)});
+        ASSERT_EQ((*batched)[0].layout(), yt::Layout::nChw8c);
+        ASSERT_EQ((*batched)[0].sizeInBytes(), alone[0].sizeInBytes());
+        EXPECT_EQ(std::memcmp((*batched)[0].data(), alone[0].data(), alone[0].sizeInBytes()), 0);
+    }
+}
@@ -0,0 +1,131 @@
+#include <buffer_pool.h>
+#include <tensor.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using yt::BufferPool;
+
+
+class BufferPoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        pool_.trim();
+    }
+
+    BufferPool &pool_ {BufferPool::instance()};
+};
+
+
+TEST_F(BufferPoolTest, SizeClassesBoundSlack)
+{
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(0)), 64);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(64)), 64);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(65)), 128);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(257)), 320);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(1000)), 1024);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(1025)), 1280);
+    EXPECT_EQ(BufferPool::sizeOfClass(BufferPool::sizeClassOf(BufferPool::kMaxPooledSize)), BufferPool::kMaxPooledSize);
+    for (std::size_t size = 1; size < 1000000; size = size * 3 / 2 + 1)
+    {
+        auto classSize = BufferPool::sizeOfClass(BufferPool::sizeClassOf(size));
+        EXPECT_GE(classSize, size);
+        EXPECT_EQ(classSize % yt::Tensor::kAlignment, 0);
+        if (size > 256)
+        {
+            EXPECT_LE(classSize, size + size / 4 + 1);
+        }
+    }
+}
+
+
+TEST_F(BufferPoolTest, ReleasedBufferIsReused)
+{
+    auto before = pool_.stats();
+    void *address;
+    {
+        auto buffer = pool_.allocate(1000);
+        address = buffer.get();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(address) % yt::Tensor::kAlignment, 0);
+        EXPECT_EQ(pool_.stats().bytesInUse, before.bytesInUse + 1024);
+    }
+    EXPECT_EQ(pool_.stats().bytesHeld, before.bytesHeld + 1024);
+    auto buffer = pool_.allocate(900);
+    EXPECT_EQ(buffer.get(), address);
+    auto after = pool_.stats();
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_GE(after.highWaterMark, after.bytesInUse);
+}
+
+
+TEST_F(BufferPoolTest, TensorsReturnStorageToPool)
+{
+    {
+        yt::Tensor tensor {yt::fp32, {16, 16}};
+    }
+    auto before = pool_.stats();
+    yt::Tensor tensor {yt::fp32, {16, 16}};
+    EXPECT_EQ(pool_.stats().hits, before.hits + 1);
+    EXPECT_EQ(pool_.stats().misses, before.misses);
+}
+
+
+TEST_F(BufferPoolTest, TrimReleasesHeldBytes)
+{
+    {
+        auto a = pool_.allocate(4096);
+        auto b = pool_.allocate(100000);
+    }
+    EXPECT_GE(pool_.stats().bytesHeld, 4096 + 100000);
+    EXPECT_GE(pool_.trim(), 4096 + 100000);
+    EXPECT_EQ(pool_.stats().bytesHeld, 0);
+}
+
+
+TEST_F(BufferPoolTest, BuffersMoveBetweenThreads)
+{
+    std::vector<std::shared_ptr<void>> buffers;
+    for (int i = 0; i < 8; i++)
+        buffers.push_back(pool_.allocate(5000));
+    auto inUse = pool_.stats().bytesInUse;
+    std::thread releaser {[&buffers]() {
+        buffers.clear();
+        // The thread cache spills into the shared bins on thread exit
+    }};
+    releaser.join();
+    auto stats = pool_.stats();
+    EXPECT_EQ(stats.bytesInUse, inUse - 8 * BufferPool::sizeOfClass(BufferPool::sizeClassOf(5000)));
+    auto hits = stats.hits;
+    auto buffer = pool_.allocate(5000);
+    EXPECT_EQ(pool_.stats().hits, hits + 1);
+}
+
+
+TEST_F(BufferPoolTest, MaxBytesHeldCapsSharedBins)
+{
+    pool_.setMaxBytesHeld(0);
+    std::thread releaser {[this]() {
+        auto buffer = pool_.allocate(4096);
+    }};
+    releaser.join();
+    EXPECT_EQ(pool_.stats().bytesHeld, 0);
+    pool_.setMaxBytesHeld(BufferPool::kDefaultMaxBytesHeld);
+}
+
+
+TEST_F(BufferPoolTest, OversizedRequestsBypassPool)
+{
+    auto before = pool_.stats();
+    {
+        auto buffer = pool_.allocate(BufferPool::kMaxPooledSize + 1);
+        ASSERT_NE(buffer.get(), nullptr);
+    }
+    auto after = pool_.stats();
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.bytesHeld, before.bytesHeld);
+    EXPECT_EQ(after.bytesInUse, before.bytesInUse);
+}
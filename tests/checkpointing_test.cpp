@@ -0,0 +1,123 @@
+#include "random_tensor.h"
+#include <graph/constant.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <runtime/checkpointing.h>
+#include <runtime/executor.h>
+#include <throw_exception.h>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace yt::graph;
+using namespace yt::runtime;
+
+// A chain of square dense layers, i.e. the shape of network checkpointing is meant for
+class CheckpointingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        input_ = std::make_shared<Input>(yt::fp32, yt::Shape{yt::kDynamicDim, kWidth}, "x");
+        TensorDescriptor::WeakPtr current = *input_;
+        for (unsigned i = 0; i < kDepth; i++)
+        {
+            auto weights = std::make_shared<Constant>(randomTensor({kWidth, kWidth}, 2 * i, -0.5f, 0.5f));
+            auto bias = std::make_shared<Constant>(randomTensor({kWidth}, 2 * i + 1, -0.5f, 0.5f));
+            auto layer = std::make_shared<Dense>(current, *weights, *bias);
+            current = *layer;
+            nodes_.insert(nodes_.end(), {weights, bias, layer});
+            layers_.push_back(layer);
+        }
+        output_ = std::make_shared<Output>(current);
+        plan_ = std::make_shared<ExecutionPlan>(compileExecutionPlan({input_}, {output_}, {{kBatch, kWidth}}));
+    }
+
+    // Every intermediate of the chain, computed without checkpointing
+    std::vector<yt::Tensor> referenceActivations(const yt::Tensor &x)
+    {
+        Nodes outputs;
+        for (auto &layer : layers_)
+            outputs.push_back(std::make_shared<Output>(*layer));
+        return Executor{{input_}, outputs}.run({x});
+    }
+
+    static constexpr std::size_t kWidth = 16;
+    static constexpr std::size_t kBatch = 4;
+    static constexpr unsigned kDepth = 16;
+    Node::Ptr input_;
+    Node::Ptr output_;
+    Nodes nodes_;
+    std::vector<Node::Ptr> layers_;
+    std::shared_ptr<ExecutionPlan> plan_;
+};
+
+
+TEST_F(CheckpointingTest, SqrtHeuristicReducesPeakMemory)
+{
+    auto checkpoints = planCheckpoints(*plan_);
+    EXPECT_GE(checkpoints.numSegments(), 3);
+    EXPECT_LE(checkpoints.numSegments(), 6);
+    // Weights and biases are parameters, only the layer outputs count as activations
+    std::size_t layerBytes = kBatch * kWidth * sizeof(float);
+    EXPECT_EQ(checkpoints.peakBytesWithoutCheckpointing, kDepth * layerBytes);
+    EXPECT_LT(checkpoints.peakBytesWithCheckpointing, checkpoints.peakBytesWithoutCheckpointing / 2);
+    EXPECT_LT(checkpoints.storedBytes, checkpoints.peakBytesWithoutCheckpointing);
+}
+
+
+TEST_F(CheckpointingTest, UserMarkedNodesBoundSegments)
+{
+    auto checkpoints = planCheckpoints(*plan_, {layers_[3].get(), layers_[9].get()});
+    ASSERT_EQ(checkpoints.numSegments(), 3);
+    auto first = checkpoints.segmentSteps(0, *plan_);
+    auto last = checkpoints.segmentSteps(2, *plan_);
+    EXPECT_EQ(first.first, 0);
+    EXPECT_EQ(plan_->steps[first.second - 1].node, layers_[3].get());
+    EXPECT_EQ(plan_->steps[last.first - 1].node, layers_[9].get());
+    EXPECT_EQ(last.second, plan_->steps.size());
+    for (std::size_t slot = 0; slot < plan_->slots.size(); slot++)
+    {
+        if (plan_->slots[slot].descriptor == layers_[3]->outputs()[0].get() ||
+            plan_->slots[slot].descriptor == layers_[9]->outputs()[0].get())
+        {
+            EXPECT_TRUE(checkpoints.stored[slot]);
+        }
+        else if (plan_->slots[slot].descriptor == layers_[5]->outputs()[0].get())
+        {
+            EXPECT_FALSE(checkpoints.stored[slot]);
+        }
+    }
+    EXPECT_THROW(planCheckpoints(*plan_, {output_.get()}), yt::Exception);
+}
+
+
+TEST_F(CheckpointingTest, RecomputedSegmentsMatchFullForward)
+{
+    auto x = randomTensor({kBatch, kWidth}, 100, -0.5f, 0.5f);
+    auto reference = referenceActivations(x);
+    CheckpointedRun run {plan_, planCheckpoints(*plan_), {x}};
+    auto results = run.results();
+    ASSERT_EQ(results.size(), 1);
+    for (std::size_t i = 0; i < results[0].numElements(); i++)
+        EXPECT_FLOAT_EQ(results[0].data<float>()[i], reference.back().data<float>()[i]);
+
+    std::vector<bool> seen(kDepth);
+    for (auto segment = run.checkpoints().numSegments(); segment-- > 0;)
+    {
+        auto tensors = run.recomputeSegment(segment);
+        auto steps = run.checkpoints().segmentSteps(segment, *plan_);
+        for (unsigned layer = 0; layer < kDepth; layer++)
+            for (auto step = steps.first; step < steps.second; step++)
+                if (plan_->steps[step].node == layers_[layer].get())
+                {
+                    const auto &activation = tensors[plan_->steps[step].outputs[0]];
+                    ASSERT_FALSE(activation.empty());
+                    for (std::size_t i = 0; i < activation.numElements(); i++)
+                        EXPECT_FLOAT_EQ(activation.data<float>()[i], reference[layer].data<float>()[i]);
+                    seen[layer] = true;
+                }
+    }
+    EXPECT_EQ(seen, std::vector<bool>(kDepth, true));
+    EXPECT_THROW(run.recomputeSegment(run.checkpoints().numSegments()), yt::Exception);
+}
@@ -0,0 +1,125 @@
+#include <graph/constant.h>
+#include <graph/conv2d.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <runtime/cost_model.h>
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+using namespace yt::graph;
+using namespace yt::runtime;
+
+namespace {
+
+std::shared_ptr<Constant> zeros(yt::Shape shape)
+{
+    yt::Tensor tensor {yt::fp32, std::move(shape)};
+    std::fill(tensor.data<float>(), tensor.data<float>() + tensor.numElements(), 0.f);
+    return std::make_shared<Constant>(std::move(tensor));
+}
+
+} // namespace
+
+
+class CostModelTest : public ::testing::Test
+{
+protected:
+    const NodeCost &costOf(const CostReport &report, const Node::Ptr &node)
+    {
+        for (const auto &cost : report.nodes)
+            if (cost.node == node.get())
+                return cost;
+        throw std::out_of_range {node->name()};
+    }
+
+    // 1 GFLOP/s and 1 GB/s, so the ridge point is at 1 FLOP/byte and seconds equal max(GFLOP, GB)
+    MachinePeaks peaks_ {1e9, 1e9};
+    Nodes parameters_;
+};
+
+
+TEST_F(CostModelTest, DenseIsMemoryBoundAndConvIsComputeBound)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{2, 8});
+    auto w = zeros({8, 4});
+    auto b = zeros({4});
+    auto dense = std::make_shared<Dense>(*x, *w, *b, "dense");
+    auto image = std::make_shared<Input>(yt::fp32, yt::Shape{1, 16, 16, 16});
+    auto filters = zeros({32, 16, 3, 3});
+    auto bias = zeros({32});
+    auto conv = std::make_shared<Conv2D>(*image, *filters, *bias, yt::kernels::Conv2DParams{1, 1}, "conv");
+    auto denseOut = std::make_shared<Output>(*dense);
+    auto convOut = std::make_shared<Output>(*conv);
+    auto plan = compileExecutionPlan({x, image}, {denseOut, convOut}, {{2, 8}, {1, 16, 16, 16}});
+    auto report = analyzeCost(plan, peaks_);
+
+    const auto &denseCost = costOf(report, dense);
+    EXPECT_DOUBLE_EQ(denseCost.flops, 2 * 4 * (2 * 8 + 1));
+    EXPECT_DOUBLE_EQ(denseCost.bytes, (2 * 8 + 8 * 4 + 4 + 2 * 4) * sizeof(float));
+    EXPECT_EQ(denseCost.bound, Bound::memory);
+    EXPECT_DOUBLE_EQ(denseCost.seconds, denseCost.bytes * 1e-9);
+
+    const auto &convCost = costOf(report, conv);
+    EXPECT_DOUBLE_EQ(convCost.flops, 32. * 16 * 16 * (2 * 16 * 3 * 3 + 1));
+    EXPECT_EQ(convCost.bound, Bound::compute);
+    EXPECT_DOUBLE_EQ(convCost.seconds, convCost.flops * 1e-9);
+    EXPECT_GT(convCost.arithmeticIntensity, peaks_.ridgePoint());
+
+    // Constants are bound to the plan, not computed
+    EXPECT_THROW(costOf(report, w), std::out_of_range);
+    double flops {};
+    for (const auto &cost : report.nodes)
+        flops += cost.flops;
+    EXPECT_DOUBLE_EQ(report.totalFlops, flops);
+}
+
+
+TEST_F(CostModelTest, CriticalPathFollowsLongestChain)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{4, 64});
+    TensorDescriptor::WeakPtr deep = *x;
+    Nodes deepLayers;
+    for (int i = 0; i < 3; i++)
+    {
+        auto w = zeros({64, 64});
+        auto b = zeros({64});
+        auto layer = std::make_shared<Dense>(deep, *w, *b);
+        deep = *layer;
+        parameters_.insert(parameters_.end(), {w, b, layer});
+        deepLayers.push_back(layer);
+    }
+    auto w = zeros({64, 2});
+    auto b = zeros({2});
+    auto shallow = std::make_shared<Dense>(*x, *w, *b);
+    auto deepOut = std::make_shared<Output>(deep);
+    auto shallowOut = std::make_shared<Output>(*shallow);
+    auto plan = compileExecutionPlan({x}, {deepOut, shallowOut}, {{4, 64}});
+    auto report = analyzeCost(plan, peaks_);
+
+    for (auto &layer : deepLayers)
+        EXPECT_TRUE(costOf(report, layer).onCriticalPath);
+    EXPECT_FALSE(costOf(report, shallow).onCriticalPath);
+    EXPECT_LT(report.criticalPathSeconds, report.serialSeconds);
+    double chain {};
+    for (auto &layer : deepLayers)
+        chain += costOf(report, layer).seconds;
+    EXPECT_GE(report.criticalPathSeconds, chain);
+
+    std::ostringstream stream;
+    stream << report;
+    EXPECT_NE(stream.str().find(deepLayers.back()->name() + " "), std::string::npos);
+    EXPECT_NE(stream.str().find("critical path"), std::string::npos);
+}
+
+
+TEST_F(CostModelTest, MeasuresMachinePeaks)
+{
+    auto peaks = measureMachinePeaks();
+    EXPECT_GT(peaks.flopsPerSecond, 1e7);
+    EXPECT_GT(peaks.bytesPerSecond, 1e7);
+    EXPECT_GT(peaks.ridgePoint(), 0.);
+}
@@ -0,0 +1,79 @@
+#include <runtime/data_parallel.h>
+#include <runtime/shm_allreduce.h>
+#include <throw_exception.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace yt::runtime;
+
+
+TEST(DataParallelTest, ShardsCoverDatasetDisjointly)
+{
+    std::size_t next {};
+    for (std::size_t rank = 0; rank < 4; rank++)
+    {
+        auto shard = shardOf(rank, 4, 10);
+        EXPECT_EQ(shard.begin, next);
+        EXPECT_GE(shard.end - shard.begin, 2);
+        EXPECT_LE(shard.end - shard.begin, 3);
+        next = shard.end;
+    }
+    EXPECT_EQ(next, 10);
+}
+
+
+TEST(DataParallelTest, SingleRankAllreduceIsIdentity)
+{
+    ShmAllreduce allreduce {1, 8};
+    std::vector<float> data {1, 2, 3};
+    allreduce.allreduce(0, data.data(), data.size());
+    EXPECT_EQ(data, (std::vector<float>{1, 2, 3}));
+    EXPECT_THROW(allreduce.allreduce(0, data.data(), 100), yt::Exception);
+}
+
+
+TEST(DataParallelTest, WorkersAllreduceGradients)
+{
+    constexpr std::size_t kWorkers = 4;
+    constexpr std::size_t kDatasetSize = 1001;
+    runDataParallel(kWorkers, kDatasetSize, 1000, [](std::size_t rank, ShardRange shard, ShmAllreduce &allreduce) {
+        // Several rounds with sizes that don't split evenly into chunks
+        for (std::size_t count : {1, 7, 333, 1000})
+        {
+            std::vector<float> gradient(count);
+            for (std::size_t i = 0; i < count; i++)
+                gradient[i] = static_cast<float>(rank * 1000 + i);
+            allreduce.allreduce(rank, gradient.data(), count);
+            for (std::size_t i = 0; i < count; i++)
+                if (gradient[i] != static_cast<float>(6000 + kWorkers * i))
+                    yt::throwException("wrong sum");
+        }
+        std::vector<float> shardSize {static_cast<float>(shard.end - shard.begin)};
+        allreduce.allreduce(rank, shardSize.data(), 1);
+        if (shardSize[0] != kDatasetSize)
+            yt::throwException("shards don't cover the dataset");
+        std::vector<float> weights {static_cast<float>(rank)};
+        allreduce.broadcast(rank, weights.data(), 1);
+        if (weights[0] != 0.f)
+            yt::throwException("broadcast failed");
+    });
+}
+
+
+TEST(DataParallelTest, FailingWorkerAbortsOthers)
+{
+    EXPECT_THROW(runDataParallel(3, 30, 16, [](std::size_t rank, ShardRange, ShmAllreduce &allreduce) {
+        if (rank == 1)
+            yt::throwException("worker failure");
+        std::vector<float> gradient(16, 1.f);
+        allreduce.allreduce(rank, gradient.data(), gradient.size());
+    }), yt::Exception);
+    EXPECT_THROW(runDataParallel(2, 30, 16, [](std::size_t rank, ShardRange, ShmAllreduce &allreduce) {
+        if (rank == 0)
+            std::abort();
+        std::vector<float> gradient(16, 1.f);
+        allreduce.allreduce(rank, gradient.data(), gradient.size());
+    }), yt::Exception);
+}
@@ -0,0 +1,192 @@
+#include <graph/constant.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <runtime/executor.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+using yt::runtime::Executor;
+
+namespace executor_fakes {
+
+class Add : public Node
+{
+public:
+    Add(const TensorDescriptor::WeakPtr &a, const TensorDescriptor::WeakPtr &b, const std::string &name) :
+        Node(std::move(std::vector<TensorDescriptor::WeakPtr>{a, b}), name)
+    {
+        auto aPtr = a.lock();
+        outputs_.push_back(std::make_shared<TensorDescriptor>(aPtr->dataType(), aPtr->shape(), this));
+    }
+
+    Kernel kernel(const std::vector<yt::Shape> &) const override
+    {
+        return [](const std::vector<const yt::Tensor*> &in, const std::vector<yt::Tensor*> &out) {
+            auto a = in[0]->data<float>();
+            auto b = in[1]->data<float>();
+            auto c = out[0]->data<float>();
+            for (std::size_t i = 0; i < out[0]->numElements(); i++)
+                c[i] = a[i] + b[i];
+        };
+    }
+};
+
+// Sums each row of a [N, K] input into a [N] output
+class RowSum : public Node
+{
+public:
+    RowSum(const TensorDescriptor::WeakPtr &a, const std::string &name) :
+        Node(std::move(std::vector<TensorDescriptor::WeakPtr>{a}), name)
+    {
+        auto aPtr = a.lock();
+        outputs_.push_back(std::make_shared<TensorDescriptor>(aPtr->dataType(), yt::Shape{aPtr->shape()[0]}, this));
+    }
+
+    Kernel kernel(const std::vector<yt::Shape> &inputShapes) const override
+    {
+        auto rowLength = inputShapes[0][1];
+        return [rowLength](const std::vector<const yt::Tensor*> &in, const std::vector<yt::Tensor*> &out) {
+            for (std::size_t row = 0; row < out[0]->numElements(); row++)
+            {
+                auto begin = in[0]->data<float>() + row * rowLength;
+                out[0]->data<float>()[row] = std::accumulate(begin, begin + rowLength, 0.f);
+            }
+        };
+    }
+};
+
+yt::Tensor makeTensor(yt::Shape shape, float start)
+{
+    yt::Tensor tensor {yt::DataType::fp32, std::move(shape)};
+    std::iota(tensor.data<float>(), tensor.data<float>() + tensor.numElements(), start);
+    return tensor;
+}
+
+} // namespace executor_fakes
+
+
+/**
+ *
+ * x ---- Add --- Add --- RowSum --- Output
+ *     \_/       /
+ * y -----------
+ *
+ */
+class ExecutorTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<Input> x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 3}, "x");
+    std::shared_ptr<Input> y = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 3}, "y");
+    std::shared_ptr<Node> add_0 = std::make_shared<executor_fakes::Add>(*x, *x, "add_0");
+    std::shared_ptr<Node> add_1 = std::make_shared<executor_fakes::Add>(*add_0, *y, "add_1");
+    std::shared_ptr<Node> sum = std::make_shared<executor_fakes::RowSum>(*add_1, "sum");
+    std::shared_ptr<Node> result = std::make_shared<Output>(*sum, "result");
+};
+
+
+TEST_F(ExecutorTest, DynamicBatchInference)
+{
+    EXPECT_TRUE(x->outputs()[0]->shape().isDynamic());
+    auto shapes = sum->inferOutputShapes({{5, 3}});
+    ASSERT_THAT(shapes, ::testing::ElementsAre(::testing::ElementsAre(5)));
+    EXPECT_THROW(sum->inferOutputShapes({}), yt::Exception);
+}
+
+
+TEST_F(ExecutorTest, RunWithDifferentBatchSizes)
+{
+    Executor executor {{x, y}, {result}};
+    for (std::size_t batch : {2, 4, 2})
+    {
+        auto results = executor.run({executor_fakes::makeTensor({batch, 3}, 0.f), executor_fakes::makeTensor({batch, 3}, 1.f)});
+        ASSERT_EQ(results.size(), 1);
+        ASSERT_THAT(results[0].shape(), ::testing::ElementsAre(batch));
+        for (std::size_t row = 0; row < batch; row++)
+        {
+            float expected {};
+            for (std::size_t col = 0; col < 3; col++)
+                expected += 2.f * (row * 3 + col) + (row * 3 + col + 1.f);
+            EXPECT_FLOAT_EQ(results[0].data<float>()[row], expected);
+        }
+    }
+    EXPECT_EQ(executor.planCache().misses(), 2);
+    EXPECT_EQ(executor.planCache().hits(), 1);
+    EXPECT_EQ(executor.planCache().size(), 2);
+}
+
+
+TEST_F(ExecutorTest, PlanCacheEvictsLeastRecentlyUsed)
+{
+    Executor executor {{x, y}, {result}, 2};
+    auto run = [&executor](std::size_t batch) {
+        executor.run({executor_fakes::makeTensor({batch, 3}, 0.f), executor_fakes::makeTensor({batch, 3}, 0.f)});
+    };
+    run(1);
+    run(2);
+    run(1);
+    run(3);
+    EXPECT_EQ(executor.planCache().misses(), 3);
+    run(1);
+    EXPECT_EQ(executor.planCache().hits(), 2);
+    run(2);
+    EXPECT_EQ(executor.planCache().misses(), 4);
+    EXPECT_EQ(executor.planCache().size(), 2);
+}
+
+
+TEST_F(ExecutorTest, MemoryPlanReusesDeadTensors)
+{
+    auto plan = yt::runtime::compileExecutionPlan({x, y}, {result}, {{8, 3}, {8, 3}});
+    ASSERT_EQ(plan.steps.size(), 3);
+    for (std::size_t i = 0; i < plan.slots.size(); i++)
+        for (std::size_t j = i + 1; j < plan.slots.size(); j++)
+        {
+            const auto &a = plan.slots[i];
+            const auto &b = plan.slots[j];
+            if (a.inputIndex >= 0 || b.inputIndex >= 0)
+                continue;
+            bool liveTogether = a.firstStep <= b.lastStep && b.firstStep <= a.lastStep;
+            bool overlap = a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+            EXPECT_FALSE(liveTogether && overlap) << i << " " << j;
+        }
+    std::size_t total {};
+    for (const auto &slot : plan.slots)
+        total += slot.size;
+    EXPECT_LT(plan.arenaSize, total);
+}
+
+
+TEST_F(ExecutorTest, MismatchedInputShapeThrows)
+{
+    Executor executor {{x, y}, {result}};
+    EXPECT_THROW(executor.run({executor_fakes::makeTensor({2, 4}, 0.f), executor_fakes::makeTensor({2, 4}, 0.f)}),
+                 yt::Exception);
+    EXPECT_THROW(executor.run({executor_fakes::makeTensor({2, 3}, 0.f)}), yt::Exception);
+}
+
+
+TEST_F(ExecutorTest, ConstantsAreBoundWithoutCopies)
+{
+    auto c = std::make_shared<Constant>(executor_fakes::makeTensor({2, 3}, 10.f), "c");
+    auto add = std::make_shared<executor_fakes::Add>(*x, *c, "add");
+    auto out = std::make_shared<Output>(*add, "out");
+    auto plan = yt::runtime::compileExecutionPlan({x}, {out}, {{2, 3}});
+    ASSERT_EQ(plan.steps.size(), 1);
+    auto slot = std::find_if(plan.slots.begin(), plan.slots.end(), [&c](const yt::runtime::TensorSlot &slot) {
+        return slot.descriptor == c->outputs()[0].get();
+    });
+    ASSERT_NE(slot, plan.slots.end());
+    EXPECT_EQ(slot->constant, &c->value());
+    EXPECT_EQ(slot->size, 0);
+    EXPECT_EQ(plan.arenaSize, slot->size + yt::Tensor::kAlignment);
+
+    auto results = Executor{{x}, {out}}.run({executor_fakes::makeTensor({2, 3}, 0.f)});
+    for (std::size_t i = 0; i < 6; i++)
+        EXPECT_EQ(results[0].data<float>()[i], 2.f * i + 10.f);
+}
@@ -0,0 +1,85 @@
+#include "random_tensor.h"
+#include <graph/batch_norm.h>
+#include <graph/constant.h>
+#include <graph/conv2d.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/passes/fold_batch_norm.h>
+#include <runtime/executor.h>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace yt::graph;
+
+class FoldBatchNormTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<BatchNorm> makeBatchNorm(const TensorDescriptor::WeakPtr &input, std::size_t channels, unsigned seed)
+    {
+        auto scale = std::make_shared<Constant>(randomTensor({channels}, seed, 0.5f, 2.f));
+        auto shift = std::make_shared<Constant>(randomTensor({channels}, seed + 1));
+        auto mean = std::make_shared<Constant>(randomTensor({channels}, seed + 2));
+        auto variance = std::make_shared<Constant>(randomTensor({channels}, seed + 3, 0.1f, 3.f));
+        auto batchNorm = std::make_shared<BatchNorm>(input, *scale, *shift, *mean, *variance);
+        parameters_.insert(parameters_.end(), {scale, shift, mean, variance});
+        return batchNorm;
+    }
+
+    void expectFoldPreserves(const Nodes &inputs, const Nodes &outputs, const std::vector<yt::Tensor> &values,
+                             std::size_t expectedFolds)
+    {
+        auto before = yt::runtime::Executor{inputs, outputs}.run(values);
+        EXPECT_EQ(foldBatchNorm(inputs, outputs), expectedFolds);
+        auto after = yt::runtime::Executor{inputs, outputs}.run(values);
+        ASSERT_EQ(before.size(), after.size());
+        for (std::size_t i = 0; i < before.size(); i++)
+            for (std::size_t j = 0; j < before[i].numElements(); j++)
+                EXPECT_NEAR(before[i].data<float>()[j], after[i].data<float>()[j], 1e-4);
+        if (expectedFolds)
+        {
+            for (auto &node : traverseInExecutionOrder(inputs, outputs))
+                EXPECT_EQ(std::dynamic_pointer_cast<BatchNorm>(node), nullptr);
+        }
+    }
+
+    std::vector<Node::Ptr> parameters_;
+};
+
+
+TEST_F(FoldBatchNormTest, FoldsIntoDense)
+{
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 5}, "x");
+    auto w = std::make_shared<Constant>(randomTensor({5, 3}, 1));
+    auto b = std::make_shared<Constant>(randomTensor({3}, 2));
+    auto dense = std::make_shared<Dense>(*x, *w, *b);
+    auto batchNorm = makeBatchNorm(*dense, 3, 10);
+    auto result = std::make_shared<Output>(*batchNorm);
+    expectFoldPreserves({x}, {result}, {randomTensor({4, 5}, 3)}, 1);
+    EXPECT_TRUE(batchNorm->outputs()[0]->consumers().empty());
+}
+
+
+TEST_F(FoldBatchNormTest, FoldsIntoConv2D)
+{
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 2, 5, 5}, "x");
+    auto w = std::make_shared<Constant>(randomTensor({3, 2, 3, 3}, 4));
+    auto b = std::make_shared<Constant>(randomTensor({3}, 5));
+    auto conv = std::make_shared<Conv2D>(*x, *w, *b);
+    auto batchNorm = makeBatchNorm(*conv, 3, 20);
+    auto result = std::make_shared<Output>(*batchNorm);
+    expectFoldPreserves({x}, {result}, {randomTensor({2, 2, 5, 5}, 6)}, 1);
+}
+
+
+TEST_F(FoldBatchNormTest, SkipsSharedLayerOutput)
+{
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{2, 5}, "x");
+    auto w = std::make_shared<Constant>(randomTensor({5, 3}, 1));
+    auto b = std::make_shared<Constant>(randomTensor({3}, 2));
+    auto dense = std::make_shared<Dense>(*x, *w, *b);
+    auto batchNorm = makeBatchNorm(*dense, 3, 30);
+    auto result = std::make_shared<Output>(*batchNorm);
+    auto raw = std::make_shared<Output>(*dense);
+    expectFoldPreserves({x}, {result, raw}, {randomTensor({2, 5}, 3)}, 0);
+}
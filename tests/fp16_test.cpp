@@ -0,0 +1,138 @@
+#include <kernels/convert.h>
+#include <kernels/fp16.h>
+#include <tensor.h>
+#include <throw_exception.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using yt::kernels::half;
+using yt::kernels::halfToFloat;
+using yt::kernels::floatToHalf;
+
+
+TEST(Fp16Test, ScalarExactValues)
+{
+    EXPECT_EQ(floatToHalf(0.f), 0x0000);
+    EXPECT_EQ(floatToHalf(-0.f), 0x8000);
+    EXPECT_EQ(floatToHalf(1.f), 0x3c00);
+    EXPECT_EQ(floatToHalf(-2.f), 0xc000);
+    EXPECT_EQ(floatToHalf(65504.f), 0x7bff);
+    EXPECT_EQ(floatToHalf(std::ldexp(1.f, -24)), 0x0001);
+    EXPECT_EQ(floatToHalf(std::ldexp(1.f, -14)), 0x0400);
+    EXPECT_FLOAT_EQ(halfToFloat(0x3555), 0.333251953125f);
+    EXPECT_FLOAT_EQ(halfToFloat(0x0001), std::ldexp(1.f, -24));
+    EXPECT_FLOAT_EQ(halfToFloat(0x7bff), 65504.f);
+}
+
+
+TEST(Fp16Test, ScalarRounding)
+{
+    // 1 + 2^-11 is halfway between 1 and the next half: ties go to even
+    EXPECT_EQ(floatToHalf(1.f + std::ldexp(1.f, -11)), 0x3c00);
+    EXPECT_EQ(floatToHalf(1.f + 3 * std::ldexp(1.f, -11)), 0x3c02);
+    EXPECT_EQ(floatToHalf(65519.f), 0x7bff);
+    EXPECT_EQ(floatToHalf(65520.f), 0x7c00);
+    EXPECT_EQ(floatToHalf(std::ldexp(1.f, -26)), 0x0000);
+}
+
+
+TEST(Fp16Test, ScalarSpecialValues)
+{
+    EXPECT_EQ(floatToHalf(std::numeric_limits<float>::infinity()), 0x7c00);
+    EXPECT_EQ(floatToHalf(-std::numeric_limits<float>::infinity()), 0xfc00);
+    EXPECT_TRUE(std::isnan(halfToFloat(floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::isinf(halfToFloat(0x7c00)));
+}
+
+
+TEST(Fp16Test, AllHalvesRoundTrip)
+{
+    for (std::uint32_t bits = 0; bits <= 0xffff; bits++)
+    {
+        auto value = static_cast<half>(bits);
+        if ((value & 0x7c00) == 0x7c00 && (value & 0x3ff))
+            continue;
+        ASSERT_EQ(floatToHalf(halfToFloat(value)), value) << bits;
+    }
+}
+
+
+TEST(Fp16Test, BulkMatchesScalar)
+{
+    std::mt19937 gen {42};
+    std::uniform_real_distribution<float> distrib {-70000.f, 70000.f};
+    for (std::size_t count : {0, 1, 7, 8, 15, 16, 17, 100})
+    {
+        std::vector<float> src(count);
+        for (auto &value : src)
+            value = distrib(gen) * std::ldexp(1.f, static_cast<int>(gen() % 40) - 30);
+        std::vector<half> halves(count);
+        yt::kernels::convertFloatToHalf(src.data(), halves.data(), count);
+        std::vector<float> back(count);
+        yt::kernels::convertHalfToFloat(halves.data(), back.data(), count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(halves[i], floatToHalf(src[i])) << src[i];
+            EXPECT_EQ(back[i], halfToFloat(halves[i]));
+        }
+    }
+}
+
+
+TEST(Fp16Test, TensorConversion)
+{
+    yt::Tensor tensor {yt::DataType::fp32, {2, 3}};
+    for (int i = 0; i < 6; i++)
+        tensor.data<float>()[i] = i * 0.5f - 1.f;
+    auto halfTensor = tensor.toDataType(yt::DataType::fp16);
+    EXPECT_EQ(halfTensor.dataType(), yt::DataType::fp16);
+    EXPECT_EQ(halfTensor.sizeInBytes(), 12);
+    ASSERT_THAT(halfTensor.shape(), ::testing::ElementsAre(2, 3));
+    std::vector<float> loaded(4);
+    yt::kernels::loadAsFloat(halfTensor, 2, 4, loaded.data());
+    ASSERT_THAT(loaded, ::testing::ElementsAre(0.f, 0.5f, 1.f, 1.5f));
+    auto back = halfTensor.toDataType(yt::DataType::int32);
+    ASSERT_THAT(std::vector<int>(back.data<int>(), back.data<int>() + 6), ::testing::ElementsAre(-1, 0, 0, 0, 1, 1));
+}
+
+
+TEST(Fp16Test, IntegerConversionSaturates)
+{
+    yt::Tensor tensor {yt::DataType::fp32, {7}};
+    std::vector<float> values {std::numeric_limits<float>::quiet_NaN(), 1e30f, -1e30f, 3.7f, -3.7f, 300.f, 2147483520.f};
+    std::copy(values.begin(), values.end(), tensor.data<float>());
+    auto int8 = tensor.toDataType(yt::DataType::int8);
+    EXPECT_THAT(std::vector<int>(int8.data<std::int8_t>(), int8.data<std::int8_t>() + 7),
+                ::testing::ElementsAre(0, 127, -128, 3, -3, 127, 127));
+    auto uint16 = tensor.toDataType(yt::DataType::uint16);
+    EXPECT_THAT(std::vector<int>(uint16.data<std::uint16_t>(), uint16.data<std::uint16_t>() + 7),
+                ::testing::ElementsAre(0, 65535, 0, 3, 0, 300, 65535));
+    auto int32 = tensor.toDataType(yt::DataType::int32);
+    EXPECT_THAT(std::vector<std::int32_t>(int32.data<std::int32_t>(), int32.data<std::int32_t>() + 7),
+                ::testing::ElementsAre(0, std::numeric_limits<std::int32_t>::max(),
+                                       std::numeric_limits<std::int32_t>::min(), 3, -3, 300, 2147483520));
+    auto uint64 = tensor.toDataType(yt::DataType::uint64);
+    EXPECT_EQ(uint64.data<std::uint64_t>()[1], std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(uint64.data<std::uint64_t>()[2], 0);
+
+    // Integer narrowing clamps too, and uint16 holds integers rather than fp16 bit patterns
+    auto narrowed = int32.toDataType(yt::DataType::uint8);
+    EXPECT_THAT(std::vector<int>(narrowed.data<std::uint8_t>(), narrowed.data<std::uint8_t>() + 7),
+                ::testing::ElementsAre(0, 255, 0, 3, 0, 255, 255));
+    std::vector<float> loaded(7);
+    yt::kernels::loadAsFloat(uint16, 0, 7, loaded.data());
+    EXPECT_FLOAT_EQ(loaded[5], 300.f);
+}
+
+
+TEST(Fp16Test, OutOfRangeAccessThrows)
+{
+    yt::Tensor tensor {yt::DataType::fp16, {4}};
+    std::vector<float> buffer(8);
+    EXPECT_THROW(yt::kernels::loadAsFloat(tensor, 2, 4, buffer.data()), yt::Exception);
+    EXPECT_THROW(yt::kernels::loadAsFloat(yt::Tensor{}, 0, 0, buffer.data()), yt::Exception);
+}
@@ -0,0 +1,122 @@
+#include "random_tensor.h"
+#include <graph/batch_norm.h>
+#include <graph/constant.h>
+#include <graph/conv2d.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/pooling.h>
+#include <kernels/layers.h>
+#include <runtime/executor.h>
+#include <throw_exception.h>
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+
+namespace {
+
+yt::Tensor tensorOf(yt::Shape shape, std::vector<float> values)
+{
+    yt::Tensor tensor {yt::DataType::fp32, std::move(shape)};
+    std::copy(values.begin(), values.end(), tensor.data<float>());
+    return tensor;
+}
+
+} // namespace
+
+
+TEST(LayersTest, DenseMatchesReference)
+{
+    auto x = randomTensor({3, 70}, 1);
+    auto w = randomTensor({70, 300}, 2);
+    auto b = randomTensor({300}, 3);
+    yt::Tensor y {yt::DataType::fp32, {3, 300}};
+    yt::kernels::dense(x, w.toDataType(yt::DataType::fp16).toDataType(yt::DataType::fp32), b, y);
+    auto w16 = w.toDataType(yt::DataType::fp16);
+    yt::Tensor y16 {yt::DataType::fp32, {3, 300}};
+    yt::kernels::dense(x, w16, b, y16);
+    for (std::size_t n = 0; n < 3; n++)
+        for (std::size_t m = 0; m < 300; m++)
+        {
+            double expected = b.data<float>()[m];
+            for (std::size_t k = 0; k < 70; k++)
+                expected += x.data<float>()[n * 70 + k] * static_cast<double>(w.data<float>()[k * 300 + m]);
+            EXPECT_NEAR(y.data<float>()[n * 300 + m], expected, 5e-2);
+            EXPECT_FLOAT_EQ(y16.data<float>()[n * 300 + m], y.data<float>()[n * 300 + m]);
+        }
+}
+
+
+TEST(LayersTest, Conv2DMatchesDirectConvolution)
+{
+    auto x = randomTensor({2, 3, 7, 6}, 4);
+    auto w = randomTensor({4, 3, 3, 3}, 5);
+    auto b = randomTensor({4}, 6);
+    yt::kernels::Conv2DParams params {2, 1};
+    yt::Tensor y {yt::DataType::fp32, {2, 4, 4, 3}};
+    yt::kernels::conv2d(x, w, b, params, y);
+    for (int n = 0; n < 2; n++)
+        for (int o = 0; o < 4; o++)
+            for (int oh = 0; oh < 4; oh++)
+                for (int ow = 0; ow < 3; ow++)
+                {
+                    double expected = b.data<float>()[o];
+                    for (int c = 0; c < 3; c++)
+                        for (int kh = 0; kh < 3; kh++)
+                            for (int kw = 0; kw < 3; kw++)
+                            {
+                                int ih = oh * 2 + kh - 1, iw = ow * 2 + kw - 1;
+                                if (ih < 0 || iw < 0 || ih >= 7 || iw >= 6)
+                                    continue;
+                                expected += x.data<float>()[((n * 3 + c) * 7 + ih) * 6 + iw] *
+                                            w.data<float>()[((o * 3 + c) * 3 + kh) * 3 + kw];
+                            }
+                    EXPECT_NEAR(y.data<float>()[((n * 4 + o) * 4 + oh) * 3 + ow], expected, 1e-5);
+                }
+}
+
+
+TEST(LayersTest, Pooling)
+{
+    auto x = tensorOf({1, 1, 3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+    yt::Tensor y {yt::DataType::fp32, {1, 1, 2, 2}};
+    yt::kernels::pool2d(x, {yt::kernels::PoolingType::max, 2, 1, 0}, y);
+    ASSERT_THAT(std::vector<float>(y.data<float>(), y.data<float>() + 4), ::testing::ElementsAre(5, 6, 8, 9));
+    yt::kernels::pool2d(x, {yt::kernels::PoolingType::average, 2, 2, 1}, y);
+    ASSERT_THAT(std::vector<float>(y.data<float>(), y.data<float>() + 4), ::testing::ElementsAre(1, 2.5f, 5.5f, 7));
+}
+
+
+TEST(LayersTest, BatchNorm)
+{
+    auto x = tensorOf({2, 2, 1, 1}, {1, 2, 3, 4});
+    yt::Tensor y {yt::DataType::fp32, {2, 2, 1, 1}};
+    yt::kernels::batchNorm(x, tensorOf({2}, {2, 1}), tensorOf({2}, {0, 10}), tensorOf({2}, {1, 2}),
+                           tensorOf({2}, {4, 1}), 0.f, y);
+    ASSERT_THAT(std::vector<float>(y.data<float>(), y.data<float>() + 4), ::testing::ElementsAre(0, 10, 2, 12));
+}
+
+
+TEST(LayersTest, NodesInferShapesAndRun)
+{
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 1, 8, 8}, "x");
+    auto w = std::make_shared<Constant>(randomTensor({2, 1, 3, 3}, 7));
+    auto b = std::make_shared<Constant>(randomTensor({2}, 8));
+    auto conv = std::make_shared<Conv2D>(*x, *w, *b, yt::kernels::Conv2DParams{1, 1});
+    auto pool = std::make_shared<MaxPool2D>(*conv, 2, 2);
+    auto avg = std::make_shared<AvgPool2D>(*pool, 2, 2);
+    ASSERT_THAT(conv->outputs()[0]->shape(), ::testing::ElementsAre(yt::kDynamicDim, 2, 8, 8));
+    ASSERT_THAT(avg->outputs()[0]->shape(), ::testing::ElementsAre(yt::kDynamicDim, 2, 2, 2));
+    ASSERT_THAT(pool->name(), ::testing::StartsWith("max_pool_"));
+    auto result = std::make_shared<Output>(*avg);
+    yt::runtime::Executor executor {{x}, {result}};
+    auto outputs = executor.run({randomTensor({3, 1, 8, 8}, 9)});
+    ASSERT_THAT(outputs[0].shape(), ::testing::ElementsAre(3, 2, 2, 2));
+
+    auto dx = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{yt::kDynamicDim, 4}, "dx");
+    EXPECT_THROW((Dense{*dx, *w, *b}), yt::Exception);
+    EXPECT_THROW((MaxPool2D{*dx, 2, 2}), yt::Exception);
+}
@@ -0,0 +1,244 @@
+#include "random_tensor.h"
+#include <graph/batch_norm.h>
+#include <graph/constant.h>
+#include <graph/conv2d.h>
+#include <graph/elementwise.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/passes/assign_layouts.h>
+#include <graph/pooling.h>
+#include <graph/reorder.h>
+#include <kernels/layers.h>
+#include <kernels/reorder.h>
+#include <runtime/executor.h>
+#include <throw_exception.h>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace yt::graph;
+using yt::Layout;
+
+namespace {
+
+yt::Tensor toLayout(const yt::Tensor &tensor, Layout layout)
+{
+    yt::Tensor result {yt::fp32, tensor.shape(), layout};
+    yt::kernels::reorder(tensor, result);
+    return result;
+}
+
+void expectNear(const yt::Tensor &actual, const yt::Tensor &expected, float tolerance = 1e-4f)
+{
+    ASSERT_EQ(actual.shape(), expected.shape());
+    auto plain = toLayout(actual, Layout::nchw);
+    for (std::size_t i = 0; i < expected.numElements(); i++)
+        EXPECT_NEAR(plain.data<float>()[i], expected.data<float>()[i], tolerance) << "at " << i;
+}
+
+} // namespace
+
+
+TEST(LayoutTest, TransposeMatchesNaive)
+{
+    auto src = randomTensor({13, 21}, 1);
+    std::vector<float> dst(21 * 16, -1.f);
+    yt::kernels::transpose(src.data<float>(), 13, 21, 21, dst.data(), 16);
+    for (std::size_t r = 0; r < 13; r++)
+        for (std::size_t c = 0; c < 21; c++)
+            EXPECT_EQ(dst[c * 16 + r], src.data<float>()[r * 21 + c]);
+    EXPECT_EQ(dst[15], -1.f);
+}
+
+
+TEST(LayoutTest, ReordersRoundTripThroughAllLayouts)
+{
+    auto x = randomTensor({2, 11, 5, 7}, 2);
+    auto blocked = toLayout(x, Layout::nChw8c);
+    EXPECT_EQ(blocked.sizeInBytes(), 2 * 16 * 5 * 7 * sizeof(float));
+    auto at = [](const yt::Tensor &t, std::size_t n, std::size_t c, std::size_t h, std::size_t w) {
+        return t.data<float>()[((n * 11 + c) * 5 + h) * 7 + w];
+    };
+    for (std::size_t n = 0; n < 2; n++)
+        for (std::size_t c = 0; c < 16; c++)
+            for (std::size_t h = 0; h < 5; h++)
+                for (std::size_t w = 0; w < 7; w++)
+                {
+                    auto value = blocked.data<float>()[(((n * 2 + c / 8) * 5 + h) * 7 + w) * 8 + c % 8];
+                    EXPECT_EQ(value, c < 11 ? at(x, n, c, h, w) : 0.f);
+                }
+    auto nhwc = toLayout(x, Layout::nhwc);
+    EXPECT_EQ(nhwc.data<float>()[((1 * 5 + 2) * 7 + 3) * 11 + 4], at(x, 1, 4, 2, 3));
+    expectNear(toLayout(toLayout(nhwc, Layout::nChw8c), Layout::nhwc), x, 0.f);
+    expectNear(toLayout(blocked, Layout::nhwc), x, 0.f);
+    expectNear(blocked, x, 0.f);
+    EXPECT_THROW(toLayout(randomTensor({2, 3}, 3), Layout::nhwc), yt::Exception);
+}
+
+
+TEST(LayoutTest, LayersAgreeAcrossLayouts)
+{
+    auto x = randomTensor({2, 11, 9, 9}, 4);
+    auto w = randomTensor({10, 11, 3, 3}, 5);
+    auto b = randomTensor({10}, 6);
+    yt::kernels::Conv2DParams convParams {2, 1};
+    yt::Tensor expected {yt::fp32, {2, 10, 5, 5}};
+    yt::kernels::conv2d(x, w, b, convParams, expected);
+    yt::Tensor blocked {yt::fp32, {2, 10, 5, 5}, Layout::nChw8c};
+    yt::kernels::conv2d(toLayout(x, Layout::nChw8c), w, b, convParams, blocked);
+    expectNear(blocked, expected);
+    EXPECT_THROW(yt::kernels::conv2d(toLayout(x, Layout::nChw8c), w, b, convParams, expected), yt::Exception);
+
+    for (auto type : {yt::kernels::PoolingType::max, yt::kernels::PoolingType::average})
+    {
+        yt::kernels::Pool2DParams poolParams {type, 3, 2, 1};
+        yt::Tensor pooled {yt::fp32, {2, 11, 5, 5}};
+        yt::kernels::pool2d(x, poolParams, pooled);
+        for (auto layout : {Layout::nhwc, Layout::nChw8c})
+        {
+            yt::Tensor result {yt::fp32, {2, 11, 5, 5}, layout};
+            yt::kernels::pool2d(toLayout(x, layout), poolParams, result);
+            expectNear(result, pooled);
+        }
+    }
+
+    auto scale = randomTensor({11}, 7, 0.5f, 2.f);
+    auto shift = randomTensor({11}, 8);
+    auto mean = randomTensor({11}, 9);
+    auto variance = randomTensor({11}, 10, 0.1f, 2.f);
+    yt::Tensor normalized {yt::fp32, x.shape()};
+    yt::kernels::batchNorm(x, scale, shift, mean, variance, 1e-5f, normalized);
+    for (auto layout : {Layout::nhwc, Layout::nChw8c})
+    {
+        yt::Tensor result {yt::fp32, x.shape(), layout};
+        yt::kernels::batchNorm(toLayout(x, layout), scale, shift, mean, variance, 1e-5f, result);
+        expectNear(result, normalized);
+    }
+}
+
+
+class AssignLayoutsTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<Constant> constant(yt::Shape shape, unsigned seed, float low = -1.f, float high = 1.f)
+    {
+        auto node = std::make_shared<Constant>(randomTensor(std::move(shape), seed, low, high));
+        parameters_.push_back(node);
+        return node;
+    }
+
+    std::shared_ptr<Conv2D> conv(const TensorDescriptor::WeakPtr &input, std::size_t in, std::size_t out, unsigned seed)
+    {
+        auto w = constant({out, in, 3, 3}, seed);
+        auto b = constant({out}, seed + 1);
+        return std::make_shared<Conv2D>(input, *w, *b, yt::kernels::Conv2DParams{1, 1});
+    }
+
+    std::vector<yt::Tensor> run(const Nodes &inputs, const Nodes &outputs, const yt::Tensor &x)
+    {
+        return yt::runtime::Executor{inputs, outputs}.run({x});
+    }
+
+    Nodes parameters_;
+};
+
+
+TEST_F(AssignLayoutsTest, InsertsReordersOnlyAtBoundaries)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{yt::kDynamicDim, 3, 12, 12}, "x");
+    auto conv1 = conv(*x, 3, 16, 1);
+    auto batchNorm = std::make_shared<BatchNorm>(*conv1, *constant({16}, 3, 0.5f, 2.f), *constant({16}, 4),
+                                                 *constant({16}, 5), *constant({16}, 6, 0.1f, 2.f));
+    auto pool = std::make_shared<MaxPool2D>(*batchNorm, 2, 2);
+    auto conv2 = conv(*pool, 16, 8, 7);
+    auto output = std::make_shared<Output>(*conv2);
+    auto input = randomTensor({2, 3, 12, 12}, 8);
+    auto before = run({x}, {output}, input);
+
+    auto assignment = assignLayouts({x}, {output});
+    EXPECT_EQ(assignment.reorders.size(), 2);
+    for (auto node : std::vector<Node*>{conv1.get(), batchNorm.get(), pool.get(), conv2.get()})
+        EXPECT_EQ(node->outputs().front()->layout(), Layout::nChw8c) << node->name();
+    EXPECT_EQ(conv1->inputs().front().lock()->producer(), assignment.reorders.front().get());
+    EXPECT_EQ(output->inputs().front().lock()->layout(), Layout::nchw);
+    expectNear(run({x}, {output}, input)[0], before[0]);
+
+    // Running the pass again finds nothing to do
+    auto again = assignLayouts({x}, {output});
+    EXPECT_TRUE(again.reorders.empty());
+    EXPECT_EQ(again.cancelled, 0);
+}
+
+
+TEST_F(AssignLayoutsTest, ResidualAddsKeepTheBlockedLayout)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{yt::kDynamicDim, 3, 10, 10}, "x");
+    auto conv1 = conv(*x, 3, 11, 1);
+    auto conv2 = conv(*conv1, 11, 11, 3);
+    auto residual = std::make_shared<Add>(*conv2, *conv1);
+    auto conv3 = conv(*residual, 11, 4, 5);
+    auto output = std::make_shared<Output>(*conv3);
+    auto input = randomTensor({2, 3, 10, 10}, 7);
+    auto before = run({x}, {output}, input);
+
+    // Only x and the result are reordered; the add reads both convolutions in their blocked layout
+    auto assignment = assignLayouts({x}, {output});
+    EXPECT_EQ(assignment.reorders.size(), 2);
+    EXPECT_EQ(residual->outputs().front()->layout(), Layout::nChw8c);
+    EXPECT_EQ(residual->inputs()[0].lock()->producer(), conv2.get());
+    EXPECT_EQ(residual->inputs()[1].lock()->producer(), conv1.get());
+    expectNear(run({x}, {output}, input)[0], before[0]);
+}
+
+
+TEST_F(AssignLayoutsTest, BroadcastAddsStayNchw)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{1, 8, 6, 6}, "x");
+    auto conv1 = conv(*x, 8, 8, 1);
+    auto shift = constant({8, 1, 1}, 3);
+    auto add = std::make_shared<Add>(*conv1, *shift);
+    auto output = std::make_shared<Output>(*add);
+    auto input = randomTensor({1, 8, 6, 6}, 4);
+    auto before = run({x}, {output}, input);
+
+    auto assignment = assignLayouts({x}, {output});
+    EXPECT_EQ(assignment.reorders.size(), 2);
+    EXPECT_EQ(conv1->outputs().front()->layout(), Layout::nChw8c);
+    EXPECT_EQ(add->outputs().front()->layout(), Layout::nchw);
+    expectNear(run({x}, {output}, input)[0], before[0]);
+}
+
+
+TEST_F(AssignLayoutsTest, CheapNodesKeepTheirInputLayout)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{1, 8, 6, 6}, "x");
+    auto pool = std::make_shared<AvgPool2D>(*x, 2, 2);
+    auto output = std::make_shared<Output>(*pool);
+    auto assignment = assignLayouts({x}, {output});
+    EXPECT_TRUE(assignment.reorders.empty());
+    EXPECT_EQ(pool->outputs().front()->layout(), Layout::nchw);
+}
+
+
+TEST_F(AssignLayoutsTest, CancelsInverseReorders)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{1, 4, 8, 8}, "x");
+    auto conv1 = conv(*x, 4, 8, 1);
+    auto toPlain = std::make_shared<Reorder>(*conv1, Layout::nchw);
+    auto toBlocked = std::make_shared<Reorder>(*toPlain, Layout::nChw8c);
+    auto toPlainAgain = std::make_shared<Reorder>(*toBlocked, Layout::nchw);
+    auto pool = std::make_shared<MaxPool2D>(*toPlainAgain, 2, 2);
+    auto output = std::make_shared<Output>(*pool);
+    auto input = randomTensor({1, 4, 8, 8}, 3);
+    auto before = run({x}, {output}, input);
+
+    auto assignment = assignLayouts({x}, {output});
+    // Reorder(nchw) -> Reorder(nChw8c) collapses onto the blocked conv output, and the last reorder
+    // then reads the conv output directly
+    EXPECT_GE(assignment.cancelled, 1);
+    // Only the blocking of x for the conv is new
+    EXPECT_EQ(assignment.reorders.size(), 1);
+    EXPECT_EQ(conv1->outputs().front()->layout(), Layout::nChw8c);
+    EXPECT_EQ(toPlainAgain->inputs().front().lock()->producer(), conv1.get());
+    EXPECT_EQ(pool->outputs().front()->layout(), Layout::nchw);
+    expectNear(run({x}, {output}, input)[0], before[0]);
+}
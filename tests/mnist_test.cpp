@@ -107,3 +107,17 @@ TEST_F(MnistTest, LoadMoreLabelsThanAvailableTest) {
     yt::dataset::Mnist mnist {mnistImages_, mnistLabels_};
     EXPECT_THROW(mnist.loadLabels(10), std::out_of_range);
 }
+
+TEST_F(MnistTest, SeekToShardTest) {
+    yt::dataset::Mnist mnist {mnistImages_, mnistLabels_};
+    mnist.seek(1);
+    auto imageBytes = mnist.loadImages(1);
+    auto labels = mnist.loadLabels(1);
+    ASSERT_EQ(imageBytes.size(), 4);
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(imageBytes[i], 4 + i);
+    EXPECT_EQ(labels[0], 1);
+    mnist.seek(0);
+    EXPECT_EQ(mnist.loadLabels(1)[0], 0);
+    EXPECT_THROW(mnist.seek(3), std::out_of_range);
+}
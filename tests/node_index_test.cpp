@@ -0,0 +1,85 @@
+#include <graph/input.h>
+#include <graph/node_index.h>
+#include <graph/output.h>
+#include <graph/visited_set.h>
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+
+
+TEST(NodeIndexTest, IdsAreUniqueAndReused)
+{
+    auto a = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1});
+    auto b = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1});
+    EXPECT_NE(a->id(), b->id());
+    auto freedId = a->id();
+    a.reset();
+    auto c = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1});
+    EXPECT_LE(c->id(), freedId);
+}
+
+
+TEST(NodeIndexTest, FindByNameAndId)
+{
+    auto input = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1}, "input");
+    auto result = std::make_shared<Output>(*input, "result");
+    NodeIndex index {traverseInExecutionOrder({input}, {result})};
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(index.find("input"), input.get());
+    EXPECT_EQ(index.find(std::string{"result"}), result.get());
+    EXPECT_EQ(index.find("missing"), nullptr);
+    EXPECT_EQ(index.find(input->id()), input.get());
+    EXPECT_EQ(index.find(result->id()), result.get());
+    EXPECT_EQ(index.find(std::max(input->id(), result->id()) + 1), nullptr);
+}
+
+
+TEST(NodeIndexTest, VisitedSetEpochs)
+{
+    auto a = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1});
+    auto b = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1});
+    VisitedSet visited;
+    EXPECT_TRUE(visited.insert(*a));
+    EXPECT_FALSE(visited.insert(*a));
+    EXPECT_TRUE(visited.contains(*a));
+    EXPECT_FALSE(visited.contains(*b));
+    visited.clear();
+    EXPECT_FALSE(visited.contains(*a));
+    EXPECT_TRUE(visited.insert(*b));
+}
+
+
+TEST(NodeIndexTest, ConcurrentGraphConstruction)
+{
+    constexpr int kThreads = 4;
+    constexpr int kNodesPerThread = 500;
+    std::vector<std::vector<Node::Ptr>> graphs(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+        threads.emplace_back([&graph = graphs[t]]() {
+            graph.push_back(std::make_shared<Input>(yt::DataType::fp32, yt::Shape{1}));
+            for (int i = 1; i < kNodesPerThread; i++)
+                graph.push_back(std::make_shared<Output>(*graph.front()));
+        });
+    for (auto &thread : threads)
+        thread.join();
+    std::set<std::size_t> ids;
+    std::set<std::string> names;
+    for (auto &graph : graphs)
+        for (auto &node : graph)
+        {
+            ids.insert(node->id());
+            names.insert(node->name());
+        }
+    EXPECT_EQ(ids.size(), kThreads * kNodesPerThread);
+    EXPECT_EQ(names.size(), kThreads * kNodesPerThread);
+    for (auto &graph : graphs)
+        EXPECT_EQ(graph.front()->outputs()[0]->consumers().size(), kNodesPerThread - 1);
+}
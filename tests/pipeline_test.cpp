@@ -0,0 +1,120 @@
+#include <runtime/pipeline.h>
+#include <runtime/thread_pool.h>
+#include <throw_exception.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using yt::runtime::Pipeline;
+using yt::runtime::ThreadPool;
+
+
+TEST(ThreadPoolTest, ParallelForCoversRange)
+{
+    ThreadPool pool {4};
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(0, hits.size(), [&hits](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            hits[i]++;
+    });
+    for (auto &hit : hits)
+        EXPECT_EQ(hit.load(), 1);
+}
+
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    ThreadPool pool {2};
+    std::atomic<int> total {};
+    pool.parallelFor(0, 8, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            pool.parallelFor(0, 10, [&total](std::size_t b, std::size_t e) { total += static_cast<int>(e - b); });
+    });
+    EXPECT_EQ(total.load(), 80);
+}
+
+
+TEST(ThreadPoolTest, ParallelForRethrows)
+{
+    ThreadPool pool {2};
+    EXPECT_THROW(pool.parallelFor(0, 100, [](std::size_t begin, std::size_t) {
+        if (begin == 0)
+            yt::throwException("failure");
+    }), yt::Exception);
+}
+
+
+struct FakeBatch
+{
+    std::vector<int> data;
+    int sum {};
+};
+
+
+TEST(PipelineTest, StagesSeeBatchesInOrder)
+{
+    ThreadPool pool {4};
+    Pipeline<FakeBatch> pipeline {pool, 3};
+    std::vector<std::vector<std::size_t>> seen(3);
+    std::vector<int> sums;
+    pipeline.addStage([&seen](FakeBatch &batch, std::size_t index) {
+        seen[0].push_back(index);
+        batch.data.assign(4, static_cast<int>(index));
+    }).addStage([&seen](FakeBatch &batch, std::size_t index) {
+        seen[1].push_back(index);
+        batch.sum = std::accumulate(batch.data.begin(), batch.data.end(), 0);
+    }).addStage([&seen, &sums](FakeBatch &batch, std::size_t index) {
+        seen[2].push_back(index);
+        sums.push_back(batch.sum);
+    });
+    pipeline.run(10);
+    std::vector<std::size_t> expected(10);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (auto &stageOrder : seen)
+        EXPECT_EQ(stageOrder, expected);
+    ASSERT_EQ(sums.size(), 10);
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(sums[i], 4 * i);
+    EXPECT_LE(pipeline.maxObservedInFlight(), 3);
+}
+
+
+TEST(PipelineTest, StagesOverlapAcrossBatches)
+{
+    using namespace std::chrono_literals;
+    ThreadPool pool {3};
+    Pipeline<FakeBatch> pipeline {pool, 2};
+    std::atomic<int> running {};
+    std::atomic<int> maxRunning {};
+    auto stage = [&](FakeBatch &, std::size_t) {
+        auto now = ++running;
+        for (auto seen = maxRunning.load(); now > seen && !maxRunning.compare_exchange_weak(seen, now);)
+            ;
+        std::this_thread::sleep_for(5ms);
+        running--;
+    };
+    pipeline.addStage(stage).addStage(stage).addStage(stage);
+    pipeline.run(8);
+    EXPECT_GT(maxRunning.load(), 1);
+    EXPECT_EQ(pipeline.maxObservedInFlight(), 2);
+}
+
+
+TEST(PipelineTest, StageFailureStopsPipeline)
+{
+    ThreadPool pool {2};
+    Pipeline<FakeBatch> pipeline {pool, 2};
+    std::atomic<std::size_t> lastStageRuns {};
+    pipeline.addStage([](FakeBatch &, std::size_t index) {
+        if (index == 3)
+            yt::throwException("load failure");
+    }).addStage([&lastStageRuns](FakeBatch &, std::size_t) { lastStageRuns++; });
+    EXPECT_THROW(pipeline.run(10), yt::Exception);
+    EXPECT_LE(lastStageRuns.load(), 3);
+    EXPECT_THROW((Pipeline<FakeBatch>{pool, 0}), yt::Exception);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <tensor.h>
+#include <random>
+
+// fp32 tensor of values drawn uniformly from [low, high), reproducible per seed
+inline yt::Tensor randomTensor(yt::Shape shape, unsigned seed, float low = -1.f, float high = 1.f)
+{
+    std::mt19937 gen {seed};
+    std::uniform_real_distribution<float> distrib {low, high};
+    yt::Tensor tensor {yt::DataType::fp32, std::move(shape)};
+    for (std::size_t i = 0; i < tensor.numElements(); i++)
+        tensor.data<float>()[i] = distrib(gen);
+    return tensor;
+}
@@ -0,0 +1,163 @@
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/softmax_cross_entropy.h>
+#include <kernels/fast_exp.h>
+#include <kernels/softmax_cross_entropy.h>
+#include <runtime/executor.h>
+#include <runtime/thread_pool.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+
+namespace {
+
+void referenceSoftmaxCrossEntropy(const float *logits, int label, std::size_t classes, double &loss, std::vector<double> &grad)
+{
+    double max = logits[0];
+    for (std::size_t i = 1; i < classes; i++)
+        max = std::max<double>(max, logits[i]);
+    double sum {};
+    for (std::size_t i = 0; i < classes; i++)
+        sum += std::exp(logits[i] - max);
+    loss = max + std::log(sum) - logits[label];
+    grad.resize(classes);
+    for (std::size_t i = 0; i < classes; i++)
+        grad[i] = std::exp(logits[i] - max) / sum - (static_cast<int>(i) == label ? 1. : 0.);
+}
+
+} // namespace
+
+
+TEST(SoftmaxCrossEntropyTest, FastExpRelativeError)
+{
+    double worst {};
+    for (float x = -87.f; x <= 88.f; x += 0.0137f)
+        worst = std::max(worst, std::abs(yt::kernels::fastExp(x) / std::exp(static_cast<double>(x)) - 1.));
+    EXPECT_LT(worst, 2e-7);
+    EXPECT_TRUE(std::isfinite(yt::kernels::fastExp(1000.f)));
+    EXPECT_GE(yt::kernels::fastExp(-1000.f), 0.f);
+}
+
+
+TEST(SoftmaxCrossEntropyTest, VectorExpMatchesScalarBitForBit)
+{
+    // Values whose exponent split x * log2(e) lands exactly halfway between two integers, where
+    // rounding differences would show, plus a sweep in between
+    std::vector<float> values;
+    for (int k = -14; k < 0; k++)
+    {
+        auto x = static_cast<float>((k + 0.5) * std::log(2.));
+        for (int step = 0; step < 64; step++, x = std::nextafter(x, 0.f))
+            if (x * 1.44269504088896341f == k + 0.5f)
+                values.push_back(x);
+    }
+    ASSERT_FALSE(values.empty());
+    for (float x = -10.f; x < 0.f; x += 0.0173f)
+        values.push_back(x);
+
+    // Eight classes keep each row on the vector path: the tested value, the maximum 0 and six
+    // logits too small to change the row sum, so the gradient is exactly e / (1 + e)
+    constexpr std::size_t kClasses = 8;
+    yt::Tensor logits {yt::DataType::fp32, {values.size(), kClasses}};
+    yt::Tensor labels {yt::DataType::uint8, {values.size()}};
+    for (std::size_t row = 0; row < values.size(); row++)
+    {
+        auto *logitRow = logits.data<float>() + row * kClasses;
+        std::fill(logitRow, logitRow + kClasses, -1000.f);
+        logitRow[0] = values[row];
+        logitRow[1] = 0.f;
+        labels.data<std::uint8_t>()[row] = 1;
+    }
+    yt::Tensor loss {yt::DataType::fp32, {values.size()}};
+    yt::Tensor gradient {yt::DataType::fp32, {values.size(), kClasses}};
+    yt::kernels::softmaxCrossEntropy(logits, labels, loss, &gradient);
+    for (std::size_t row = 0; row < values.size(); row++)
+    {
+        auto e = yt::kernels::fastExp(values[row]);
+        EXPECT_EQ(gradient.data<float>()[row * kClasses], e * (1.f / (1.f + e))) << "x = " << values[row];
+    }
+}
+
+
+TEST(SoftmaxCrossEntropyTest, MatchesReference)
+{
+    constexpr std::size_t kBatch = 37;
+    constexpr std::size_t kClasses = 19;
+    std::mt19937 gen {3};
+    std::normal_distribution<float> distrib {0.f, 10.f};
+    yt::Tensor logits {yt::DataType::fp32, {kBatch, kClasses}};
+    yt::Tensor labels {yt::DataType::uint8, {kBatch}};
+    for (std::size_t i = 0; i < logits.numElements(); i++)
+        logits.data<float>()[i] = distrib(gen);
+    for (std::size_t i = 0; i < kBatch; i++)
+        labels.data<std::uint8_t>()[i] = static_cast<std::uint8_t>(gen() % kClasses);
+    yt::Tensor loss {yt::DataType::fp32, {kBatch}};
+    yt::Tensor gradient {yt::DataType::fp32, {kBatch, kClasses}};
+    yt::runtime::ThreadPool pool {3};
+    yt::kernels::softmaxCrossEntropy(logits, labels, loss, &gradient, &pool);
+    std::vector<double> expectedGrad;
+    for (std::size_t row = 0; row < kBatch; row++)
+    {
+        double expectedLoss;
+        referenceSoftmaxCrossEntropy(logits.data<float>() + row * kClasses, labels.data<std::uint8_t>()[row], kClasses,
+                                     expectedLoss, expectedGrad);
+        EXPECT_NEAR(loss.data<float>()[row], expectedLoss, 1e-4 * std::max(1., std::abs(expectedLoss)));
+        for (std::size_t i = 0; i < kClasses; i++)
+            EXPECT_NEAR(gradient.data<float>()[row * kClasses + i], expectedGrad[i], 1e-5);
+    }
+}
+
+
+TEST(SoftmaxCrossEntropyTest, LargeLogitsStayFinite)
+{
+    yt::Tensor logits {yt::DataType::fp32, {1, 3}};
+    logits.data<float>()[0] = 1e4f;
+    logits.data<float>()[1] = -1e4f;
+    logits.data<float>()[2] = 1e4f - 1.f;
+    yt::Tensor labels {yt::DataType::int32, {1}};
+    labels.data<std::int32_t>()[0] = 1;
+    yt::Tensor loss {yt::DataType::fp32, {1}};
+    yt::kernels::softmaxCrossEntropy(logits, labels, loss, nullptr);
+    EXPECT_NEAR(loss.data<float>()[0], 2e4f + std::log1p(std::exp(-1.f)), 1.f);
+    labels.data<std::int32_t>()[0] = 3;
+    EXPECT_THROW(yt::kernels::softmaxCrossEntropy(logits, labels, loss, nullptr), yt::Exception);
+}
+
+
+TEST(SoftmaxCrossEntropyTest, NodeRunsWithFp16LogitsAndDynamicBatch)
+{
+    auto logits = std::make_shared<Input>(yt::DataType::fp16, yt::Shape{yt::kDynamicDim, 4}, "logits");
+    auto labels = std::make_shared<Input>(yt::DataType::int64, yt::Shape{yt::kDynamicDim}, "labels");
+    auto loss = std::make_shared<SoftmaxCrossEntropy>(*logits, *labels);
+    auto lossOutput = std::make_shared<Output>(loss->outputs()[0]);
+    auto gradOutput = std::make_shared<Output>(loss->outputs()[1]);
+    ASSERT_THAT(loss->name(), ::testing::StartsWith("softmax_cross_entropy_"));
+    yt::runtime::Executor executor {{logits, labels}, {lossOutput, gradOutput}};
+
+    yt::Tensor logitValues {yt::DataType::fp32, {2, 4}};
+    for (int i = 0; i < 8; i++)
+        logitValues.data<float>()[i] = i % 4;
+    yt::Tensor labelValues {yt::DataType::int64, {2}};
+    labelValues.data<std::int64_t>()[0] = 3;
+    labelValues.data<std::int64_t>()[1] = 0;
+    auto results = executor.run({logitValues.toDataType(yt::DataType::fp16), labelValues});
+    ASSERT_EQ(results.size(), 2);
+    double expected[2];
+    std::vector<double> grad;
+    referenceSoftmaxCrossEntropy(logitValues.data<float>(), 3, 4, expected[0], grad);
+    EXPECT_NEAR(results[0].data<float>()[0], expected[0], 1e-5);
+    EXPECT_NEAR(results[1].data<float>()[3], grad[3], 1e-6);
+    referenceSoftmaxCrossEntropy(logitValues.data<float>() + 4, 0, 4, expected[1], grad);
+    EXPECT_NEAR(results[0].data<float>()[1], expected[1], 1e-5);
+    EXPECT_NEAR(results[1].data<float>()[4], grad[0], 1e-6);
+
+    auto badLabels = std::make_shared<Input>(yt::DataType::int64, yt::Shape{3}, "bad_labels");
+    auto fixedLogits = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{2, 4}, "fixed_logits");
+    EXPECT_THROW((SoftmaxCrossEntropy{*fixedLogits, *badLabels}), yt::Exception);
+}
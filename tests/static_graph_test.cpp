@@ -0,0 +1,104 @@
+#include <graph/constant.h>
+#include <graph/dense.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/static_graph.h>
+#include <runtime/executor.h>
+#include <random>
+#include <type_traits>
+#include <gtest/gtest.h>
+
+namespace sg = yt::graph::static_graph;
+
+namespace {
+
+template<std::size_t Size>
+void fillRandom(std::array<float, Size> &values, unsigned seed)
+{
+    std::mt19937 gen {seed};
+    std::uniform_real_distribution<float> distrib {-1.f, 1.f};
+    for (auto &value : values)
+        value = distrib(gen);
+}
+
+using X = sg::Input<0, sg::StaticShape<2, 3>>;
+using Y = sg::Input<1, sg::StaticShape<2, 3>>;
+using Sum = sg::Add<X, Y>;
+using Diamond = sg::Add<sg::Relu<Sum>, Sum>;
+
+static_assert(std::is_same_v<sg::TopologicalOrder<Diamond>, sg::TypeList<X, Y, Sum, sg::Relu<Sum>, Diamond>>,
+              "shared subexpressions are visited once, after their arguments");
+static_assert(sg::StaticGraph<Diamond>::kNumInputs == 2 && sg::StaticGraph<Diamond>::kNumOutputs == 1);
+static_assert(std::is_same_v<sg::Dense<X, 7>::Shape, sg::StaticShape<2, 7>>);
+static_assert(sg::InputsAreDense<sg::TopologicalOrder<Diamond>>::value);
+static_assert(!sg::InputsAreDense<sg::TopologicalOrder<sg::Relu<X>, sg::Relu<sg::Input<0, sg::StaticShape<8>>>>>::value,
+              "two inputs sharing index 0 leave index 1 unbound");
+static_assert(!sg::InputsAreDense<sg::TopologicalOrder<sg::Relu<Y>>>::value, "a lone input must be #0");
+
+} // namespace
+
+
+TEST(StaticGraphTest, EvaluatesSharedSubexpression)
+{
+    sg::StaticGraph<Diamond, Sum> graph;
+    std::array<float, 6> x {1, -2, 3, -4, 5, -6};
+    std::array<float, 6> y {0, 0, -5, 0, 1, 1};
+    std::array<float, 6> diamond {};
+    std::array<float, 6> sum {};
+    graph.run({x.data(), y.data()}, {diamond.data(), sum.data()});
+    EXPECT_EQ(sum, (std::array<float, 6>{1, -2, -2, -4, 6, -5}));
+    EXPECT_EQ(diamond, (std::array<float, 6>{2, -2, -2, -4, 12, -5}));
+}
+
+
+TEST(StaticGraphTest, DenseMatchesRuntimeGraph)
+{
+    using In = sg::Input<0, sg::StaticShape<3, 5>>;
+    using First = sg::Dense<In, 4>;
+    using Second = sg::Dense<First, 2>;
+    sg::StaticGraph<Second> model;
+    fillRandom(model.parameters<First>().weights, 1);
+    fillRandom(model.parameters<First>().bias, 2);
+    fillRandom(model.parameters<Second>().weights, 3);
+    fillRandom(model.parameters<Second>().bias, 4);
+    std::array<float, 15> input;
+    fillRandom(input, 5);
+    std::array<float, 6> staticResult {};
+    model.run({input.data()}, {staticResult.data()});
+
+    auto constant = [](const float *values, yt::Shape shape) {
+        yt::Tensor tensor {yt::fp32, shape};
+        std::copy(values, values + tensor.numElements(), tensor.data<float>());
+        return std::make_shared<yt::graph::Constant>(tensor);
+    };
+    auto x = std::make_shared<yt::graph::Input>(yt::fp32, yt::Shape{3, 5});
+    auto w1 = constant(model.parameters<First>().weights.data(), {5, 4});
+    auto b1 = constant(model.parameters<First>().bias.data(), {4});
+    auto w2 = constant(model.parameters<Second>().weights.data(), {4, 2});
+    auto b2 = constant(model.parameters<Second>().bias.data(), {2});
+    auto first = std::make_shared<yt::graph::Dense>(*x, *w1, *b1);
+    auto second = std::make_shared<yt::graph::Dense>(*first, *w2, *b2);
+    auto output = std::make_shared<yt::graph::Output>(*second);
+    yt::Tensor inputTensor {yt::fp32, {3, 5}};
+    std::copy(input.begin(), input.end(), inputTensor.data<float>());
+    auto runtimeResult = yt::runtime::Executor{{x}, {output}}.run({inputTensor});
+    ASSERT_EQ(runtimeResult[0].numElements(), staticResult.size());
+    for (std::size_t i = 0; i < staticResult.size(); i++)
+        EXPECT_NEAR(staticResult[i], runtimeResult[0].data<float>()[i], 1e-5);
+}
+
+
+TEST(StaticGraphTest, TaggedLayersAreDistinct)
+{
+    using In = sg::Input<0, sg::StaticShape<1, 2>>;
+    using Left = sg::Dense<In, 1, struct LeftTag>;
+    using Right = sg::Dense<In, 1, struct RightTag>;
+    sg::StaticGraph<sg::Add<Left, Right>> model;
+    model.parameters<Left>().weights = {1, 2};
+    model.parameters<Right>().weights = {10, 20};
+    model.parameters<Right>().bias = {100};
+    std::array<float, 2> input {1, 1};
+    float result {};
+    model.run({input.data()}, {&result});
+    EXPECT_EQ(result, 133.f);
+}
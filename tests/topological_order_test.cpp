@@ -0,0 +1,195 @@
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/traversal.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace yt::graph;
+
+namespace topological_fakes {
+
+class Unary : public Node
+{
+public:
+    Unary(const TensorDescriptor::WeakPtr &a, const std::string &name) :
+        Node(std::move(std::vector<TensorDescriptor::WeakPtr>{a}), name)
+    {
+        outputs_.push_back(std::make_shared<TensorDescriptor>(yt::DataType::fp32, yt::Shape{4}, this));
+    }
+};
+
+class Binary : public Node
+{
+public:
+    Binary(const TensorDescriptor::WeakPtr &a, const TensorDescriptor::WeakPtr &b, const std::string &name) :
+        Node(std::move(std::vector<TensorDescriptor::WeakPtr>{a, b}), name)
+    {
+        outputs_.push_back(std::make_shared<TensorDescriptor>(yt::DataType::fp32, yt::Shape{4}, this));
+    }
+};
+
+void expectEdgesOrdered(const std::vector<Node::Ptr> &nodes)
+{
+    for (auto &node : nodes)
+        for (auto &input : node->inputs())
+            if (auto descriptor = input.lock())
+            {
+                EXPECT_LT(descriptor->producer()->topologicalIndex(), node->topologicalIndex())
+                        << descriptor->producer()->name() << " -> " << node->name();
+            }
+}
+
+} // namespace topological_fakes
+
+
+TEST(TopologicalOrderTest, CreationOrderIsTopological)
+{
+    using namespace topological_fakes;
+    auto input = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "input");
+    auto a = std::make_shared<Unary>(*input, "a");
+    auto b = std::make_shared<Binary>(*a, *input, "b");
+    expectEdgesOrdered({input, a, b});
+}
+
+
+TEST(TopologicalOrderTest, ReplaceInputReordersAffectedNodes)
+{
+    using namespace topological_fakes;
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "x");
+    auto a = std::make_shared<Unary>(*x, "a");
+    auto b = std::make_shared<Unary>(*a, "b");
+    auto y = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "y");
+    auto c = std::make_shared<Unary>(*y, "c");
+    auto d = std::make_shared<Unary>(*c, "d");
+    ASSERT_LT(a->topologicalIndex(), d->topologicalIndex());
+    a->replaceInput(0, *d);
+    expectEdgesOrdered({x, a, b, y, c, d});
+    EXPECT_TRUE(x->outputs()[0]->consumers().empty());
+    ASSERT_THAT(d->outputs()[0]->consumers(), ::testing::ElementsAre(a.get()));
+    EXPECT_EQ(a->inputs()[0].lock(), d->outputs()[0]);
+}
+
+
+TEST(TopologicalOrderTest, ReplaceInputRejectsCycles)
+{
+    using namespace topological_fakes;
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "x");
+    auto a = std::make_shared<Unary>(*x, "a");
+    auto b = std::make_shared<Unary>(*a, "b");
+    auto c = std::make_shared<Unary>(*b, "c");
+    EXPECT_THROW(a->replaceInput(0, *c), yt::Exception);
+    EXPECT_THROW(a->replaceInput(0, *a), yt::Exception);
+    EXPECT_THROW(a->replaceInput(1, *x), yt::Exception);
+    EXPECT_EQ(a->inputs()[0].lock(), x->outputs()[0]);
+    ASSERT_THAT(x->outputs()[0]->consumers(), ::testing::ElementsAre(a.get()));
+    expectEdgesOrdered({x, a, b, c});
+}
+
+
+TEST(TopologicalOrderTest, TraverseInTopologicalOrder)
+{
+    using namespace topological_fakes;
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "x");
+    auto a = std::make_shared<Unary>(*x, "a");
+    auto y = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "y");
+    auto b = std::make_shared<Binary>(*a, *y, "b");
+    auto result = std::make_shared<Output>(*b, "result");
+    auto c = std::make_shared<Unary>(*y, "c");
+    a->replaceInput(0, *c);
+    auto ordered = traverseInTopologicalOrder({y}, {result});
+    std::vector<std::string> names;
+    for (auto &node : ordered)
+        names.push_back(node->name());
+    ASSERT_THAT(names, ::testing::ElementsAre("y", "c", "a", "b", "result"));
+    auto executionOrder = traverseInExecutionOrder({y}, {result});
+    EXPECT_EQ(std::set<Node::Ptr>(ordered.begin(), ordered.end()),
+              std::set<Node::Ptr>(executionOrder.begin(), executionOrder.end()));
+    EXPECT_THROW(traverseInTopologicalOrder({x}, {result}), yt::Exception);
+}
+
+
+TEST(TopologicalOrderTest, TraversalsVisitSharedSubgraphsOnce)
+{
+    using namespace topological_fakes;
+    // 64 stacked diamonds: 2^64 paths from the output back to the input
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "x");
+    std::vector<Node::Ptr> nodes {x};
+    for (int i = 0; i < 64; i++)
+    {
+        auto left = std::make_shared<Unary>(*nodes.back(), "left_" + std::to_string(i));
+        auto right = std::make_shared<Unary>(*nodes.back(), "right_" + std::to_string(i));
+        auto join = std::make_shared<Binary>(*left, *right, "join_" + std::to_string(i));
+        nodes.insert(nodes.end(), {left, right, join});
+    }
+    auto result = std::make_shared<Output>(*nodes.back(), "result");
+    nodes.push_back(result);
+    auto executionOrder = traverseInExecutionOrder({x}, {result});
+    EXPECT_EQ(executionOrder.size(), nodes.size());
+    std::map<const Node*, std::size_t> position;
+    for (auto &node : executionOrder)
+    {
+        for (auto &input : node->inputs())
+            EXPECT_TRUE(position.count(input.lock()->producer())) << node->name();
+        position[node.get()] = position.size();
+    }
+    EXPECT_EQ(traverseInTopologicalOrder({x}, {result}).size(), nodes.size());
+}
+
+
+TEST(TopologicalOrderTest, TraversalSkipsInterleavedGraphs)
+{
+    using namespace topological_fakes;
+    auto x = std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "x");
+    // Nodes of other graphs fill the index span between x and its consumers
+    std::vector<Node::Ptr> others;
+    for (int i = 0; i < 2000; i++)
+        others.push_back(std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "other_" + std::to_string(i)));
+    auto a = std::make_shared<Unary>(*x, "a");
+    auto b = std::make_shared<Binary>(*a, *x, "b");
+    auto result = std::make_shared<Output>(*b, "result");
+    EXPECT_THAT(traverseInTopologicalOrder({x}, {result}), ::testing::ElementsAre(x, a, b, result));
+    others.resize(1000);
+    auto c = std::make_shared<Unary>(*b, "c");
+    auto second = std::make_shared<Output>(*c, "second");
+    EXPECT_THAT(traverseInTopologicalOrder({x}, {second, result}), ::testing::ElementsAre(x, a, b, result, c, second));
+}
+
+
+TEST(TopologicalOrderTest, RandomEditsKeepOrderValid)
+{
+    using namespace topological_fakes;
+    std::mt19937 gen {7};
+    std::vector<Node::Ptr> nodes {std::make_shared<Input>(yt::DataType::fp32, yt::Shape{4}, "input")};
+    for (int i = 0; i < 200; i++)
+    {
+        auto a = nodes[gen() % nodes.size()];
+        auto b = nodes[gen() % nodes.size()];
+        nodes.push_back(std::make_shared<Binary>(*a, *b, "node_" + std::to_string(i)));
+    }
+    int applied {};
+    for (int i = 0; i < 500; i++)
+    {
+        auto consumer = nodes[1 + gen() % (nodes.size() - 1)];
+        auto producer = nodes[gen() % nodes.size()];
+        try
+        {
+            consumer->replaceInput(gen() % 2, *producer);
+            applied++;
+        }
+        catch (const yt::Exception &)
+        {
+        }
+        if (i % 50 == 0)
+            nodes.erase(nodes.begin() + 1 + gen() % (nodes.size() - 1));
+    }
+    EXPECT_GT(applied, 0);
+    expectEdgesOrdered(nodes);
+}
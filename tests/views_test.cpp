@@ -0,0 +1,240 @@
+#include <graph/constant.h>
+#include <graph/dense.h>
+#include <graph/elementwise.h>
+#include <graph/input.h>
+#include <graph/output.h>
+#include <graph/views.h>
+#include <kernels/elementwise.h>
+#include <kernels/strided.h>
+#include <runtime/checkpointing.h>
+#include <runtime/executor.h>
+#include <throw_exception.h>
+#include <algorithm>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace yt::graph;
+using namespace yt::runtime;
+
+namespace {
+
+// Elements 0, 1, 2, ... in row-major order
+yt::Tensor iota(yt::Shape shape)
+{
+    yt::Tensor tensor {yt::fp32, std::move(shape)};
+    for (std::size_t i = 0; i < tensor.numElements(); i++)
+        tensor.data<float>()[i] = static_cast<float>(i);
+    return tensor;
+}
+
+yt::Tensor filled(yt::Shape shape, float value)
+{
+    yt::Tensor tensor {yt::fp32, std::move(shape)};
+    std::fill(tensor.data<float>(), tensor.data<float>() + tensor.numElements(), value);
+    return tensor;
+}
+
+std::vector<float> elements(const yt::Tensor &tensor)
+{
+    auto dense = tensor.contiguous();
+    return {dense.data<float>(), dense.data<float>() + dense.numElements()};
+}
+
+} // namespace
+
+
+TEST(StridedLoopTest, CoalescesDimensions)
+{
+    yt::kernels::StridedLoop<1> contiguous {{2, 1, 3, 4}, {yt::Strides{12, 12, 4, 1}}};
+    EXPECT_EQ(contiguous.shape, (yt::Shape{24}));
+    EXPECT_TRUE(contiguous.unitRows());
+
+    // Transposed [3, 4] and a dense destination: nothing merges
+    yt::kernels::StridedLoop<2> transposed {{4, 3}, {yt::Strides{3, 1}, yt::Strides{1, 4}}};
+    EXPECT_EQ(transposed.shape, (yt::Shape{4, 3}));
+    EXPECT_EQ(transposed.rowStride(1), 4);
+    std::vector<std::ptrdiff_t> rows;
+    transposed.forEachRow([&rows](const std::array<std::ptrdiff_t, 2> &offsets) { rows.push_back(offsets[1]); });
+    EXPECT_EQ(rows, (std::vector<std::ptrdiff_t>{0, 1, 2, 3}));
+
+    // A batch slice keeps the inner dimensions merged; a broadcast operand stays apart
+    yt::kernels::StridedLoop<2> broadcast {{2, 3, 4}, {yt::Strides{12, 4, 1}, yt::Strides{0, 4, 1}}};
+    EXPECT_EQ(broadcast.shape, (yt::Shape{2, 12}));
+    yt::kernels::StridedLoop<1> scalar {{1, 1}, {yt::Strides{5, 7}}};
+    EXPECT_EQ(scalar.shape, (yt::Shape{1}));
+}
+
+
+TEST(TensorViewTest, ViewsShareStorage)
+{
+    auto x = iota({2, 3});
+    auto row = x.view({3}, {1}, 3);
+    EXPECT_TRUE(row.isContiguous());
+    EXPECT_EQ(row.data<float>(), x.data<float>() + 3);
+    EXPECT_EQ(row.contiguous().data(), row.data());
+
+    auto transposed = x.view({3, 2}, {1, 3});
+    EXPECT_FALSE(transposed.isContiguous());
+    EXPECT_EQ(transposed.strides(), (yt::Strides{1, 3}));
+    EXPECT_EQ(elements(transposed), (std::vector<float>{0, 3, 1, 4, 2, 5}));
+    x.data<float>()[1] = 10.f;
+    EXPECT_EQ(elements(transposed)[2], 10.f);
+    EXPECT_THROW(transposed.toDataType(yt::fp16), yt::Exception);
+
+    // Strided destinations and reshaping copies
+    auto y = iota({2, 3});
+    auto yT = y.view({3, 2}, {1, 3});
+    yt::kernels::copyStrided(iota({3, 2}), yT);
+    EXPECT_EQ(elements(y), (std::vector<float>{0, 2, 4, 1, 3, 5}));
+    yt::Tensor flat {yt::fp32, {6}};
+    yt::kernels::copyStrided(transposed, flat);
+    EXPECT_EQ(elements(flat), (std::vector<float>{0, 3, 10, 4, 2, 5}));
+}
+
+
+TEST(TensorViewTest, AddBroadcastsWithoutCopies)
+{
+    yt::Tensor out {yt::fp32, {2, 3}};
+    yt::kernels::add(iota({2, 3}), iota({3}), out);
+    EXPECT_EQ(elements(out), (std::vector<float>{0, 2, 4, 3, 5, 7}));
+    yt::kernels::add(iota({2, 1}), iota({1, 3}), out);
+    EXPECT_EQ(elements(out), (std::vector<float>{0, 1, 2, 1, 2, 3}));
+    auto x = iota({3, 2});
+    yt::kernels::add(x.view({2, 3}, {1, 2}), iota({2, 3}), out);
+    EXPECT_EQ(elements(out), (std::vector<float>{0, 3, 6, 4, 7, 10}));
+    EXPECT_EQ(yt::kernels::broadcastShapes({4, 1, 3}, {5, 1}), (yt::Shape{4, 5, 3}));
+    EXPECT_THROW(yt::kernels::broadcastShapes({2, 3}, {2}), yt::Exception);
+}
+
+
+TEST(ViewNodesTest, ReshapeAliasesOnlyCompatibleStrides)
+{
+    auto x = std::make_shared<Input>(yt::fp32, yt::Shape{yt::kDynamicDim, 3, 4}, "x");
+    Reshape flatten {*x, {yt::kDynamicDim, 12}};
+    EXPECT_EQ(flatten.outputs().front()->shape(), (yt::Shape{yt::kDynamicDim, 12}));
+    EXPECT_TRUE(flatten.outputs().front()->isView());
+    auto merged = flatten.outputView({{2, 3, 4}, {12, 4, 1}, 5});
+    ASSERT_TRUE(merged);
+    EXPECT_EQ(merged->shape, (yt::Shape{2, 12}));
+    EXPECT_EQ(merged->strides, (yt::Strides{12, 1}));
+    EXPECT_EQ(merged->offset, 5);
+    // Splitting a transposed dimension is fine, merging it with its neighbour is not
+    Reshape split {*x, {yt::kDynamicDim, 4, 1, 3}};
+    auto splitView = split.outputView({{2, 12}, {1, 2}, 0});
+    ASSERT_TRUE(splitView);
+    EXPECT_EQ(splitView->strides[0], 1);
+    EXPECT_EQ(splitView->strides[1], 6);
+    EXPECT_EQ(splitView->strides[3], 2);
+    EXPECT_FALSE(flatten.outputView({{2, 3, 4}, {12, 1, 3}, 0}));
+    EXPECT_THROW((Reshape{*x, {5, yt::kDynamicDim, yt::kDynamicDim}}), yt::Exception);
+    EXPECT_THROW((Transpose{*x, {0, 0, 1}}), yt::Exception);
+    EXPECT_THROW((Transpose{*x, {}}), yt::Exception);
+    EXPECT_THROW((Transpose{*x, {1, 0}}), yt::Exception);
+    EXPECT_THROW((Slice{std::make_shared<Input>(yt::fp32, yt::Shape{2, 3})->outputs().front(), 1, 3}),
+                 yt::Exception);
+}
+
+
+class ViewPlanTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<Constant> constant(yt::Tensor value)
+    {
+        auto node = std::make_shared<Constant>(std::move(value));
+        nodes_.push_back(node);
+        return node;
+    }
+
+    std::size_t countViews(const ExecutionPlan &plan)
+    {
+        return std::count_if(plan.slots.begin(), plan.slots.end(), [](const TensorSlot &slot) {
+            return slot.viewOf >= 0;
+        });
+    }
+
+    std::size_t countMaterializations(const ExecutionPlan &plan)
+    {
+        std::size_t count {};
+        for (const auto &step : plan.steps)
+            count += step.materializations.size();
+        return count;
+    }
+
+    std::shared_ptr<Input> x_ {std::make_shared<Input>(yt::fp32, yt::Shape{yt::kDynamicDim, 3, 4}, "x")};
+    Nodes nodes_ {};
+};
+
+
+TEST_F(ViewPlanTest, SliceAndReshapeFeedDenseWithoutCopies)
+{
+    auto slice = std::make_shared<Slice>(*x_, 1, 3);
+    auto flatten = std::make_shared<Reshape>(*slice, yt::Shape{yt::kDynamicDim, 12});
+    auto dense = std::make_shared<Dense>(*flatten, *constant(filled({12, 1}, 1.f)), *constant(filled({1}, 0.f)));
+    auto output = std::make_shared<Output>(*dense);
+
+    auto plan = compileExecutionPlan({x_}, {output}, {{4, 3, 4}});
+    EXPECT_EQ(countViews(plan), 2);
+    EXPECT_EQ(countMaterializations(plan), 0);
+    // Only the dense output takes arena memory: the views alias x and the constants are bound
+    EXPECT_EQ(plan.steps.size(), 1);
+    EXPECT_EQ(plan.arenaSize, yt::Tensor::kAlignment);
+
+    auto result = Executor{{x_}, {output}}.run({iota({4, 3, 4})});
+    // Row sums of samples 1 and 2
+    EXPECT_EQ(elements(result[0]), (std::vector<float>{12 * 12 + 66, 24 * 12 + 66}));
+}
+
+
+TEST_F(ViewPlanTest, StridedViewsMaterializeOnlyForDenseKernels)
+{
+    auto transposed = std::make_shared<Transpose>(*x_, std::vector<std::size_t>{0, 2, 1});
+    auto sum = std::make_shared<Add>(*transposed, *constant(yt::Tensor{iota({3})}));
+    auto flatten = std::make_shared<Reshape>(*transposed, yt::Shape{yt::kDynamicDim, 12});
+    auto lastRow = std::make_shared<Slice>(*x_, 1, 2);
+    auto row = std::make_shared<Reshape>(*lastRow, yt::Shape{3, 4});
+    auto rowT = std::make_shared<Transpose>(*row, std::vector<std::size_t>{1, 0});
+    auto dense = std::make_shared<Dense>(*rowT, *constant(filled({3, 1}, 1.f)), *constant(filled({1}, 0.f)));
+    Nodes outputs {std::make_shared<Output>(*sum), std::make_shared<Output>(*flatten),
+                   std::make_shared<Output>(*dense), std::make_shared<Output>(*transposed)};
+
+    auto plan = compileExecutionPlan({x_}, outputs, {{2, 3, 4}});
+    // Add reads the transposed view in place; the flatten cannot alias it and copies as its own step;
+    // Dense gets a contiguous scratch copy of the transposed row
+    EXPECT_EQ(countMaterializations(plan), 1);
+    auto reshapeSteps = std::count_if(plan.steps.begin(), plan.steps.end(), [&flatten](const ExecutionStep &step) {
+        return step.node == flatten.get();
+    });
+    EXPECT_EQ(reshapeSteps, 1);
+
+    auto input = iota({2, 3, 4});
+    auto results = Executor{{x_}, outputs}.run({input});
+    std::vector<float> expectedSum, expectedTransposed, expectedDense;
+    for (std::size_t n = 0; n < 2; n++)
+        for (std::size_t w = 0; w < 4; w++)
+            for (std::size_t c = 0; c < 3; c++)
+            {
+                auto value = static_cast<float>((n * 3 + c) * 4 + w);
+                expectedSum.push_back(value + c);
+                expectedTransposed.push_back(value);
+            }
+    for (std::size_t w = 0; w < 4; w++)
+        expectedDense.push_back(static_cast<float>(3 * (12 + w) + 12));
+    EXPECT_EQ(elements(results[0]), expectedSum);
+    EXPECT_EQ(elements(results[1]), expectedTransposed);
+    EXPECT_EQ(results[1].shape(), (yt::Shape{2, 12}));
+    EXPECT_EQ(elements(results[2]), expectedDense);
+    EXPECT_EQ(elements(results[3]), expectedTransposed);
+    EXPECT_TRUE(results[3].isContiguous());
+
+    // Strided inputs are accepted too
+    auto wide = iota({3, 2, 4});
+    auto batchMajor = Executor{{x_}, outputs}.run({wide.view({2, 3, 4}, {4, 8, 1})});
+    EXPECT_EQ(elements(batchMajor[3]), elements(wide.view({2, 4, 3}, {4, 1, 8})));
+
+    // The checkpointed runner binds the same views
+    auto shared = std::make_shared<const ExecutionPlan>(std::move(plan));
+    CheckpointedRun run {shared, planCheckpoints(*shared), {input}};
+    auto checkpointed = run.results();
+    for (std::size_t i = 0; i < results.size(); i++)
+        EXPECT_EQ(elements(checkpointed[i]), elements(results[i])) << i;
+}